@@ -0,0 +1,195 @@
+// belt.cpp
+#include "belt.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+static constexpr double PI = 3.14159265358979323846;
+static constexpr double TWO_PI = 2.0 * PI;
+static constexpr double DEG = PI / 180.0;
+static constexpr size_t EVALUATE_GRAIN = 8192;
+// Sumar y restar 1.5 * 2^52 redondea al entero más cercano sin llamar a floor (se vectoriza)
+static constexpr double ROUND_MAGIC = 6755399441055744.0;
+
+BeltParams MainBeltParams(size_t count, double kmToScene) {
+    BeltParams p;
+    p.count = count;
+    p.parent = 0;
+    p.mu = GM_SUN;
+    p.kmToScene = kmToScene;
+    p.aMinKm = 2.1 * AU_KM;
+    p.aMaxKm = 3.3 * AU_KM;
+    // Resonancias con Júpiter 3:1, 5:2, 7:3 y 2:1
+    p.gaps = {{2.48 * AU_KM, 2.52 * AU_KM}, {2.81 * AU_KM, 2.84 * AU_KM},
+              {2.95 * AU_KM, 2.97 * AU_KM}, {3.26 * AU_KM, 3.30 * AU_KM}};
+    p.eSigma = 0.12;
+    p.eMax = 0.4;
+    p.iSigma = 8.0 * DEG;
+    p.color = glm::vec4(0.62f, 0.58f, 0.52f, 0.9f);
+    p.seed = 2101;
+    return p;
+}
+
+BeltParams SaturnRingParams(size_t count, size_t saturnIndex, double kmToScene) {
+    BeltParams p;
+    p.count = count;
+    p.parent = saturnIndex;
+    p.mu = GM_SATURN;
+    p.kmToScene = kmToScene;
+    p.aMinKm = 74658.0;   // borde interior del anillo C
+    p.aMaxKm = 136775.0;  // borde exterior del anillo A
+    p.gaps = {{117580.0, 122170.0}, {133410.0, 133740.0}};  // Cassini y Encke
+    p.eSigma = 0.0;
+    p.iSigma = 1e-4;  // unas decenas de km de grosor
+    // Ecuador de Saturno sobre la eclíptica
+    p.planeTilt = 28.05 * DEG;
+    p.planeNode = 169.53 * DEG;
+    p.color = glm::vec4(0.85f, 0.78f, 0.62f, 0.8f);
+    p.colorJitter = 0.25f;
+    p.seed = 6601;
+    return p;
+}
+
+static uint32_t PackColor(const glm::vec4& c) {
+    auto channel = [](float v) { return static_cast<uint32_t>(std::clamp(v, 0.0f, 1.0f) * 255.0f + 0.5f); };
+    return channel(c.r) | channel(c.g) << 8 | channel(c.b) << 16 | channel(c.a) << 24;
+}
+
+size_t ParticleBelt::Generate(const BeltParams& params) {
+    std::mt19937 rng(params.seed);
+    std::uniform_real_distribution<double> uni(0.0, 1.0);
+    auto rayleigh = [&](double sigma) { return sigma * std::sqrt(-2.0 * std::log(1.0 - uni(rng))); };
+    auto inGap = [&](double a) {
+        for (const auto& gap : params.gaps)
+            if (a >= gap.first && a <= gap.second) return true;
+        return false;
+    };
+
+    const double cbn = std::cos(params.planeNode), sbn = std::sin(params.planeNode);
+    const double cbi = std::cos(params.planeTilt), sbi = std::sin(params.planeTilt);
+    // Del plano base a la eclíptica (Rz(nodo) Rx(inclinación)) y a la escena como (x, z, -y)
+    auto toScene = [&](double x, double y, double z, double scale, float& sx, float& sy, float& sz) {
+        double y1 = cbi * y - sbi * z, z1 = sbi * y + cbi * z;
+        double x2 = cbn * x - sbn * y1, y2 = sbn * x + cbn * y1;
+        sx = static_cast<float>(x2 * scale);
+        sy = static_cast<float>(z1 * scale);
+        sz = static_cast<float>(-y2 * scale);
+    };
+
+    const size_t begin = Size();
+    const size_t total = begin + params.count;
+    for (auto* v : {&ax, &ay, &az, &bx, &by, &bz, &e, &n, &M0}) v->reserve(total);
+    colors.reserve(total);
+
+    for (size_t k = 0; k < params.count; ++k) {
+        double a;
+        do {
+            a = params.aMinKm + (params.aMaxKm - params.aMinKm) * uni(rng);
+        } while (inGap(a));
+        const double ecc = std::min(rayleigh(params.eSigma), params.eMax);
+        const double inc = rayleigh(params.iSigma);
+        const double node = TWO_PI * uni(rng), peri = TWO_PI * uni(rng);
+
+        // P y Q en el plano base, como en KeplerOrbits::Add
+        const double cw = std::cos(peri), sw = std::sin(peri);
+        const double cn = std::cos(node), sn = std::sin(node);
+        const double ci = std::cos(inc), si = std::sin(inc);
+        const double b = a * std::sqrt(1.0 - ecc * ecc);
+        float x, y, z;
+        toScene(cw * cn - sw * sn * ci, cw * sn + sw * cn * ci, sw * si, a * params.kmToScene, x, y, z);
+        ax.push_back(x); ay.push_back(y); az.push_back(z);
+        toScene(-sw * cn - cw * sn * ci, -sw * sn + cw * cn * ci, cw * si, b * params.kmToScene, x, y, z);
+        bx.push_back(x); by.push_back(y); bz.push_back(z);
+        e.push_back(static_cast<float>(ecc));
+        n.push_back(static_cast<float>(std::sqrt(params.mu / (a * a * a))));
+        M0.push_back(static_cast<float>(TWO_PI * uni(rng) - PI));
+
+        const float shade = 1.0f + params.colorJitter * static_cast<float>(2.0 * uni(rng) - 1.0);
+        colors.push_back(PackColor(glm::vec4(glm::vec3(params.color) * shade, params.color.a)));
+    }
+    populations.push_back({begin, total, params.parent});
+    return total;
+}
+
+void ParticleBelt::Clear() {
+    for (auto* v : {&ax, &ay, &az, &bx, &by, &bz, &e, &n, &M0}) v->clear();
+    colors.clear();
+    populations.clear();
+}
+
+// sin y cos de x para |x| < 2^22: x = k pi + y con y en [-pi/2, pi/2] y el signo
+// (-1)^k; polinomios de Taylor hasta grado 11 y 10 (error < 1e-6). Solo
+// aritmética: el redondeo es el truco de sumar y restar 1.5 * 2^23.
+static inline void SinCos(float x, float& s, float& c) {
+    constexpr float PI_F = 3.14159265359f, INV_PI = 0.318309886184f;
+    constexpr float ROUND_F = 12582912.0f;
+    const float k = (x * INV_PI + ROUND_F) - ROUND_F;
+    const float half = (k * 0.5f + ROUND_F) - ROUND_F;  // k / 2 redondeado: k par si coincide
+    const float sign = 1.0f - 2.0f * std::abs(k - 2.0f * half);
+    const float y = x - k * PI_F, y2 = y * y;
+    s = sign * y * (1.0f + y2 * (-1.0f / 6 + y2 * (1.0f / 120 + y2 * (-1.0f / 5040 + y2 * (1.0f / 362880 + y2 * (-1.0f / 39916800))))));
+    c = sign * (1.0f + y2 * (-0.5f + y2 * (1.0f / 24 + y2 * (-1.0f / 720 + y2 * (1.0f / 40320 + y2 * (-1.0f / 3628800))))));
+}
+
+// Un paso de Newton de M = E - e sin E; escrito tres veces en vez de en un bucle
+// para que el cuerpo quede plano y el compilador vectorice el bucle exterior
+static inline float NewtonStep(float E, float M, float ecc) {
+    float s, c;
+    SinCos(E, s, c);
+    return E - (E - ecc * s - M) / (1.0f - ecc * c);
+}
+
+// Núcleo en float sobre un bloque: anomalía media ya reducida a [-pi, pi].
+// Todo __restrict: sin eso son demasiados pares de punteros y no se vectoriza
+static void KeplerBlock(size_t count, const float* __restrict M, const float* __restrict e,
+                        const float* __restrict ax, const float* __restrict ay, const float* __restrict az,
+                        const float* __restrict bx, const float* __restrict by, const float* __restrict bz,
+                        float cx, float cy, float cz,
+                        float* __restrict x, float* __restrict y, float* __restrict z) {
+    for (size_t k = 0; k < count; ++k) {
+        const float ecc = e[k];
+        float s, c;
+        SinCos(M[k], s, c);
+        float E = M[k] + ecc * s;
+        E = NewtonStep(E, M[k], ecc);
+        E = NewtonStep(E, M[k], ecc);
+        E = NewtonStep(E, M[k], ecc);
+        SinCos(E, s, c);
+        const float u = c - ecc;
+        x[k] = cx + u * ax[k] + s * bx[k];
+        y[k] = cy + u * ay[k] + s * by[k];
+        z[k] = cz + u * az[k] + s * bz[k];
+    }
+}
+
+void ParticleBelt::EvaluateRange(double t, const glm::vec3& center, size_t begin, size_t end,
+                                 float* x, float* y, float* z) const {
+    // Por bloques: la fase en doble (t crece sin límite) se reduce a [-pi, pi] en
+    // un bucle aparte, y el resto va todo en float, que cabe el doble por registro
+    constexpr size_t BLOCK = 256;
+    float M[BLOCK];
+    for (size_t first = begin; first < end; first += BLOCK) {
+        const size_t count = std::min(BLOCK, end - first);
+        const float* pn = n.data() + first;
+        const float* pm = M0.data() + first;
+        for (size_t k = 0; k < count; ++k) {
+            const double turns = (pm[k] + static_cast<double>(pn[k]) * t) * (1.0 / TWO_PI);
+            const double whole = (turns + ROUND_MAGIC) - ROUND_MAGIC;
+            M[k] = static_cast<float>((turns - whole) * TWO_PI);
+        }
+        KeplerBlock(count, M, e.data() + first,
+                    ax.data() + first, ay.data() + first, az.data() + first,
+                    bx.data() + first, by.data() + first, bz.data() + first,
+                    center.x, center.y, center.z, x + first, y + first, z + first);
+    }
+}
+
+void ParticleBelt::Evaluate(double t, const std::vector<glm::mat4>& planets, ThreadPool& pool,
+                            float* x, float* y, float* z) const {
+    for (const Population& p : populations) {
+        const glm::vec3 center = p.parent < planets.size() ? glm::vec3(planets[p.parent][3]) : glm::vec3(0.0f);
+        pool.ParallelFor(p.end - p.begin, EVALUATE_GRAIN, [&](size_t begin, size_t end) {
+            EvaluateRange(t, center, p.begin + begin, p.begin + end, x, y, z);
+        });
+    }
+}
@@ -0,0 +1,67 @@
+// belt.h
+#pragma once
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "kepler.h"
+#include "thread_pool.h"
+
+constexpr double GM_SATURN = 3.7931187e7;  // km^3/s^2
+constexpr double SATURN_RADIUS_KM = 60268.0;
+
+// Distribución de una población de partículas sin masa en órbita kepleriana
+// alrededor de un cuerpo (índice en la lista de planetas; 0 = el Sol).
+struct BeltParams {
+    size_t count = 100000;
+    size_t parent = 0;
+    double mu = GM_SUN;
+    double kmToScene = 1.0;
+    double aMinKm = 0.0, aMaxKm = 0.0;          // semieje mayor uniforme en el intervalo
+    std::vector<std::pair<double, double>> gaps;  // huecos en a (km): Kirkwood, Cassini...
+    double eSigma = 0.0, eMax = 0.3;            // excentricidad Rayleigh, recortada
+    double iSigma = 0.0;                        // inclinación Rayleigh (rad) sobre el plano base
+    double planeTilt = 0.0, planeNode = 0.0;    // plano base respecto a la eclíptica (rad)
+    glm::vec4 color{1.0f};
+    float colorJitter = 0.15f;                  // variación de brillo por partícula
+    uint32_t seed = 1;
+};
+
+// Cinturón principal entre Marte y Júpiter (2.1-3.3 UA) con los huecos de Kirkwood
+BeltParams MainBeltParams(size_t count, double kmToScene);
+// Anillos de Saturno (C, B y A con la división de Cassini) en su plano ecuatorial
+BeltParams SaturnRingParams(size_t count, size_t saturnIndex, double kmToScene);
+
+// Partículas de prueba en SoA float con la rotación de cada órbita ya aplicada
+// (A = a P, B = b Q en unidades de escena): posición = (cos E - e) A + sin E B.
+// Evaluate resuelve Kepler para todas con un número fijo de pasos de Newton y
+// sin/cos polinómicos, sin ramas, para que el bucle se vectorice. Válido con e <= 0.5.
+class ParticleBelt {
+public:
+    size_t Generate(const BeltParams& params);  // añade una población; devuelve cuántas hay
+    size_t Size() const { return e.size(); }
+    void Clear();
+
+    // RGBA8 por partícula, fijo desde Generate
+    const std::vector<uint32_t>& Colors() const { return colors; }
+
+    // Posiciones en tiempo t (s desde J2000), cada población alrededor de la
+    // posición de su padre en `planets` (matrices de instancia). Salida en SoA:
+    // x, y, z con Size() floats cada uno (escritura contigua, se vectoriza)
+    void Evaluate(double t, const std::vector<glm::mat4>& planets, ThreadPool& pool,
+                  float* x, float* y, float* z) const;
+
+private:
+    struct Population {
+        size_t begin, end, parent;
+    };
+
+    std::vector<Population> populations;
+    std::vector<float> ax, ay, az, bx, by, bz;
+    std::vector<float> e, n, M0;
+    std::vector<uint32_t> colors;
+
+    void EvaluateRange(double t, const glm::vec3& center, size_t begin, size_t end,
+                       float* x, float* y, float* z) const;
+};
@@ -0,0 +1,364 @@
+// benchmark.cpp
+// Microbenchmarks de las rutinas calientes, sin contexto GL. Cada caso se repite
+// hasta acumular un tiempo mínimo y se guardan mediana, mínimo y media por
+// repetición; --json/--csv dejan los resultados para comparar entre versiones.
+#include "globals.h"
+#include "object.h"
+#include "planet.h"
+#include "functions.h"
+#include "spaceship.h"
+#include "physics.h"
+#include "collision.h"
+#include "grid.h"
+#include "quadtree.h"
+#include "kepler.h"
+#include "belt.h"
+#include "icosphere.h"
+#include "object_pool.h"
+#include "simd_gravity.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+// Los mismos globales que define main.cpp (functions.cpp los usa en los callbacks)
+Spaceship space;
+Simulation sim;
+SpacetimeGrid grid;
+
+struct BenchResult {
+    std::string name;
+    size_t n = 0;          // tamaño del problema (vértices, cuerpos, segmentos...)
+    int reps = 0;
+    double medianNs = 0.0, minNs = 0.0, meanNs = 0.0;
+};
+
+struct BenchOptions {
+    std::string filter;
+    double minSeconds = 0.25;  // tiempo acumulado por caso
+    int maxReps = 1000;
+    bool quick = false;        // tamaños pequeños y menos tiempo (CI)
+    bool full = false;         // incluye la suma directa con n = 100k
+};
+
+static std::vector<BenchResult> results;
+static BenchOptions options;
+static volatile float sink = 0.0f;  // evita que el compilador elimine el trabajo
+
+// fn() devuelve un valor que depende del resultado; se acumula en sink
+template <typename Fn>
+static void Bench(const std::string& name, size_t n, Fn&& fn) {
+    if (!options.filter.empty() && name.find(options.filter) == std::string::npos) return;
+    using clock = std::chrono::steady_clock;
+    sink = sink + fn();  // calentamiento: cachés, páginas, primeras asignaciones
+
+    std::vector<double> samples;
+    double total = 0.0;
+    while (static_cast<int>(samples.size()) < options.maxReps && (total < options.minSeconds * 1e9 || samples.size() < 3)) {
+        auto t0 = clock::now();
+        sink = sink + fn();
+        auto t1 = clock::now();
+        double ns = std::chrono::duration<double, std::nano>(t1 - t0).count();
+        samples.push_back(ns);
+        total += ns;
+    }
+    std::sort(samples.begin(), samples.end());
+    BenchResult r;
+    r.name = name;
+    r.n = n;
+    r.reps = static_cast<int>(samples.size());
+    r.medianNs = samples[samples.size() / 2];
+    r.minNs = samples.front();
+    r.meanNs = total / samples.size();
+    results.push_back(r);
+    std::cout << std::left << std::setw(44) << name << std::right
+              << std::setw(9) << n << std::setw(7) << r.reps
+              << std::setw(14) << std::fixed << std::setprecision(3) << r.medianNs / 1e6
+              << std::setw(14) << r.minNs / 1e6
+              << std::setw(14) << r.medianNs / std::max<size_t>(n, 1) << std::endl;
+}
+
+// Cuerpos dentro de una esfera, separados en promedio unas decenas de radios
+static std::vector<Object> RandomBodies(size_t n, float radius, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> uni(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> massDist(1e20f, 1e22f);
+    std::vector<Object> out;
+    out.reserve(n);
+    while (out.size() < n) {
+        glm::vec3 p(uni(rng), uni(rng), uni(rng));
+        if (glm::dot(p, p) > 1.0f) continue;
+        out.emplace_back(p * radius, glm::vec3(0.0f), massDist(rng));
+    }
+    return out;
+}
+
+static void BenchGeometry() {
+    for (int segments : {6, 10, 16, 24, 36, 64}) {
+        Bench("CreateSphereVertices/" + std::to_string(segments), static_cast<size_t>(segments) * segments, [&] {
+            std::vector<float> v = CreateSphereVertices(1.0f, segments, segments);
+            return v[v.size() / 2];
+        });
+    }
+    // La cadena de LOD de antes (esferas UV) y la de SphereRenderer (icosferas
+    // indexadas, con la optimización de caché de vértices incluida)
+    Bench("SphereLodChain", 5, [] {
+        float acc = 0.0f;
+        for (int segments : {36, 24, 16, 10, 6}) acc += CreateSphereVertices(1.0f, segments, segments).back();
+        return acc;
+    });
+    for (int subdivisions : {2, 4, 6}) {
+        Bench("CreateIcosphere/" + std::to_string(subdivisions), size_t(20) << (2 * subdivisions), [&] {
+            IndexedMesh mesh = CreateIcosphere(subdivisions);
+            return mesh.vertices.back();
+        });
+    }
+    Bench("IcosphereLodChain", 5, [] {
+        float acc = 0.0f;
+        for (int subdivisions : {4, 3, 2, 1, 0}) acc += CreateIcosphere(subdivisions).vertices.back();
+        return acc;
+    });
+}
+
+static void BenchGrid() {
+    const std::vector<int> divisions = options.quick ? std::vector<int>{25, 50} : std::vector<int>{25, 50, 100, 200};
+    for (int div : divisions) {
+        for (size_t bodies : {size_t(1), size_t(10), size_t(100)}) {
+            std::vector<Object> objs = RandomBodies(bodies, 20000.0f, 7u);
+            Bench("CreateGridVertices/div" + std::to_string(div) + "/bodies" + std::to_string(bodies),
+                  static_cast<size_t>(div) * div, [&] {
+                std::vector<float> v = CreateGridVertices(100000.0f, div, objs);
+                return v.empty() ? 0.0f : v[v.size() / 2];
+            });
+        }
+    }
+
+    // Kernel de la malla por frame: 501x501 vértices, escena Tierra/Luna y 100 cuerpos
+    const int side = options.quick ? 201 : 501;
+    const size_t count = static_cast<size_t>(side) * side;
+    std::vector<float> vx(count), vy(count, -9000.0f), vz(count), out(count);
+    for (size_t i = 0; i < count; ++i) {
+        vx[i] = -50000.0f + (i % side) * (100000.0f / (side - 1));
+        vz[i] = -50000.0f + (i / side) * (100000.0f / (side - 1));
+    }
+    for (size_t bodies : {size_t(2), size_t(100)}) {
+        std::vector<float> bx(bodies), by(bodies, 0.0f), bz(bodies), rs(bodies, 8.87e-3f);
+        for (size_t b = 0; b < bodies; ++b) { bx[b] = b * 300.0f; bz[b] = b * 150.0f; }
+        for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::SSE, SimdLevel::AVX2}) {
+            if (level > DetectSimdLevel()) continue;
+            Bench(std::string("GridDisplacement/") + SimdLevelName(level) + "/bodies" + std::to_string(bodies), count, [&] {
+                GridDisplacement(level, vx.data(), vy.data(), vz.data(), 0, count,
+                                 bx.data(), by.data(), bz.data(), rs.data(), bodies, out.data());
+                return out[count / 2];
+            });
+        }
+    }
+
+    // Malla adaptativa: ajuste completo y emisión de la topología
+    std::vector<GridWell> wells = {{3844.0f, 0.0f, 0.0f, 1.1f}, {0.0f, 0.0f, 0.0f, 9.9f}};  // Luna, Tierra
+    GridQuadtree tree;
+    tree.Init(100000.0f, 10, 50000);
+    Bench("GridQuadtree/Fit", 50000, [&] {
+        tree.Fit(wells.data(), wells.size(), -9000.0f);
+        return static_cast<float>(tree.LeafCount());
+    });
+    std::vector<float> qx, qz;
+    std::vector<uint32_t> indices;
+    Bench("GridQuadtree/Emit", tree.LeafCount(), [&] {
+        tree.Emit(qx, qz, indices);
+        return static_cast<float>(indices.size());
+    });
+}
+
+static void BenchMatrices() {
+    const size_t n = 1000;
+    std::vector<CelestialBody> bodies;
+    bodies.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        bodies.emplace_back(glm::vec3(0.0f), 1e8f * (i + 1) / 3e12f, 5.97e24f, 5514.0f);
+        bodies.back().SetOrbitSpeed(0.3f);
+        bodies.back().SetSelfRotationSpeed(1.0f);
+        bodies.back().SetPrecessionSpeed(0.1f);
+        bodies.back().SetNutationSpeed(0.5f);
+        bodies.back().SetNutationAmplitude(0.05f);
+        bodies.back().UpdateAnimation(0.01f * i);
+    }
+    Bench("CelestialBody::GetModelMatrix", n, [&] {
+        float acc = 0.0f;
+        for (const CelestialBody& b : bodies) acc += b.GetModelMatrix()[3].x;
+        return acc;
+    });
+    Bench("CelestialBody::GetInstanceMatrix", n, [&] {
+        float acc = 0.0f;
+        for (const CelestialBody& b : bodies) acc += b.GetInstanceMatrix()[3].x;
+        return acc;
+    });
+    Bench("CelestialBody::UpdateAnimation", n, [&] {
+        for (CelestialBody& b : bodies) b.UpdateAnimation(1.0f / 60.0f);
+        return bodies[n / 2].position.x;
+    });
+    std::vector<Object> objs = RandomBodies(n, 20000.0f, 3u);
+    Bench("Object::GetModelMatrix", n, [&] {
+        float acc = 0.0f;
+        for (const Object& o : objs) acc += o.GetModelMatrix()[3].x;
+        return acc;
+    });
+}
+
+// Órbitas keplerianas: coste por órbita independiente de t (saltos y time-warp)
+static void BenchKepler() {
+    const std::vector<size_t> sizes = options.quick ? std::vector<size_t>{9, 1000} : std::vector<size_t>{9, 1000, 100000};
+    for (size_t n : sizes) {
+        std::mt19937 rng(11u);
+        std::uniform_real_distribution<double> uni(0.0, 1.0);
+        KeplerOrbits orbits;
+        for (size_t k = 0; k < n; ++k)
+            orbits.Add(ElementsFromJ2000(2.0 + 1.5 * uni(rng), 0.3 * uni(rng), 20.0 * uni(rng),
+                                         360.0 * uni(rng), 360.0 * uni(rng), 360.0 * uni(rng)));
+        double t = 0.0;
+        Bench("KeplerOrbits::Evaluate", n, [&] {
+            t += 3.15e13;  // un millón de años por llamada
+            orbits.Evaluate(t);
+            return static_cast<float>(orbits.X()[n / 2]);
+        });
+    }
+}
+
+static void BenchBelt() {
+    const std::vector<size_t> sizes = options.quick ? std::vector<size_t>{10000} : std::vector<size_t>{100000, 1000000};
+    ThreadPool pool;
+    for (size_t n : sizes) {
+        ParticleBelt belt;
+        belt.Generate(MainBeltParams(n, 1.0e4 / AU_KM));
+        std::vector<float> out(n * 3);
+        std::vector<glm::mat4> planets(1, glm::mat4(1.0f));
+        double t = 0.0;
+        Bench("ParticleBelt::Evaluate/" + std::to_string(pool.ThreadCount()) + "t", n, [&] {
+            t += 86400.0;
+            belt.Evaluate(t, planets, pool, out.data(), out.data() + n, out.data() + 2 * n);
+            return out[n / 2];
+        });
+    }
+}
+
+static void BenchObjectPool() {
+    // Ráfaga de spawns y despawns alternos: con los huecos ya reservados no hay
+    // memoria nueva por cuerpo después de la primera repetición
+    const size_t n = options.quick ? 1000 : 10000;
+    ObjectPool pool;
+    std::vector<ObjectHandle> handles(n);
+    Bench("ObjectPool::Spawn+Despawn", n, [&] {
+        for (size_t k = 0; k < n; ++k)
+            handles[k] = pool.Spawn(glm::vec3(static_cast<float>(k), 0.0f, 0.0f), glm::vec3(0.0f), 1e20f);
+        float sum = pool[n / 2].position.x;
+        for (size_t k = 0; k < n; k += 2) pool.Despawn(handles[k]);
+        for (size_t k = 1; k < n; k += 2) pool.Despawn(handles[k]);
+        return sum;
+    });
+}
+
+static void BenchPhysics() {
+    const std::vector<size_t> sizes = options.quick ? std::vector<size_t>{10, 100, 1000}
+                                                    : std::vector<size_t>{10, 100, 1000, 10000, 100000};
+    for (size_t n : sizes) {
+        // Densidad de cuerpos fija: el volumen crece con n
+        float radius = 2000.0f * std::cbrt(static_cast<float>(n));
+        std::vector<Object> objs = RandomBodies(n, radius, 11u);
+
+        CollisionSystem collisions;
+        collisions.Resolve(objs);  // la primera pasada funde los solapes iniciales
+        Bench("Collision::Resolve/" + std::to_string(n), n, [&] {
+            collisions.Resolve(objs);
+            return static_cast<float>(collisions.Stats().candidates);
+        });
+
+        Simulation s;
+        s.Sync(objs);
+        if (n <= 20000 || options.full) {
+            s.SetForceMode(ForceMode::Direct);
+            Bench("Gravity/Direct/" + std::to_string(n), n, [&] {
+                s.ComputeAccelerations();
+                return s.Bodies().ax[n / 2];
+            });
+        }
+        s.SetForceMode(ForceMode::BarnesHut);
+        Bench("Gravity/BarnesHut/" + std::to_string(n), n, [&] {
+            s.ComputeAccelerations();
+            return s.Bodies().ax[n / 2];
+        });
+        Bench("Simulation::Step/BarnesHut/" + std::to_string(n), n, [&] {
+            s.Step();
+            return s.Bodies().px[n / 2];
+        });
+    }
+}
+
+static bool WriteJson(const std::string& path) {
+    std::ofstream out(path, std::ios::trunc);
+    if (!out) return false;
+    out << "{\n  \"simd\": \"" << SimdLevelName(DetectSimdLevel()) << "\",\n"
+        << "  \"threads\": " << sim.Pool().ThreadCount() << ",\n  \"results\": [\n";
+    out << std::fixed << std::setprecision(1);
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchResult& r = results[i];
+        out << "    {\"name\": \"" << r.name << "\", \"n\": " << r.n << ", \"reps\": " << r.reps
+            << ", \"median_ns\": " << r.medianNs << ", \"min_ns\": " << r.minNs
+            << ", \"mean_ns\": " << r.meanNs << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+    return static_cast<bool>(out);
+}
+
+static bool WriteCsv(const std::string& path) {
+    std::ofstream out(path, std::ios::trunc);
+    if (!out) return false;
+    out << "name,n,reps,median_ns,min_ns,mean_ns\n" << std::fixed << std::setprecision(1);
+    for (const BenchResult& r : results)
+        out << r.name << "," << r.n << "," << r.reps << "," << r.medianNs << "," << r.minNs << "," << r.meanNs << "\n";
+    return static_cast<bool>(out);
+}
+
+int main(int argc, char** argv) {
+    std::string jsonPath, csvPath;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--filter" && i + 1 < argc) options.filter = argv[++i];
+        else if (arg == "--json" && i + 1 < argc) jsonPath = argv[++i];
+        else if (arg == "--csv" && i + 1 < argc) csvPath = argv[++i];
+        else if (arg == "--min-time" && i + 1 < argc) options.minSeconds = std::stod(argv[++i]);
+        else if (arg == "--threads" && i + 1 < argc) sim.SetThreadCount(static_cast<unsigned>(std::stoul(argv[++i])));
+        else if (arg == "--quick") { options.quick = true; options.minSeconds = 0.05; }
+        else if (arg == "--full") options.full = true;
+        else {
+            std::cerr << "usage: benchmarks [--filter substr] [--json file] [--csv file] [--min-time s]"
+                         " [--threads n] [--quick] [--full]" << std::endl;
+            return 1;
+        }
+    }
+
+    std::cout << "simd: " << SimdLevelName(DetectSimdLevel()) << std::endl;
+    std::cout << std::left << std::setw(44) << "benchmark" << std::right << std::setw(9) << "n"
+              << std::setw(7) << "reps" << std::setw(14) << "median_ms" << std::setw(14) << "min_ms"
+              << std::setw(14) << "ns/item" << std::endl;
+    BenchGeometry();
+    BenchGrid();
+    BenchMatrices();
+    BenchKepler();
+    BenchBelt();
+    BenchObjectPool();
+    BenchPhysics();
+
+    if (!jsonPath.empty() && !WriteJson(jsonPath)) {
+        std::cerr << "Could not write " << jsonPath << std::endl;
+        return 1;
+    }
+    if (!csvPath.empty() && !WriteCsv(csvPath)) {
+        std::cerr << "Could not write " << csvPath << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,90 @@
+// collision.cpp
+#include "collision.h"
+#include <algorithm>
+#include <chrono>
+
+int CollisionSystem::Find(int i) {
+    while (parent[i] != i) {
+        parent[i] = parent[parent[i]];
+        i = parent[i];
+    }
+    return i;
+}
+
+size_t CollisionSystem::Resolve(std::vector<Object>& objs) {
+    auto t0 = std::chrono::steady_clock::now();
+    stats = CollisionStats();
+    const int n = static_cast<int>(objs.size());
+
+    // Fase amplia: intervalos en x ordenados; solo se comparan los que se solapan
+    intervals.clear();
+    for (int i = 0; i < n; ++i) {
+        if (objs[i].Initalizing) continue;  // el cuerpo que se está colocando no choca
+        intervals.push_back({objs[i].position.x - objs[i].radius,
+                             objs[i].position.x + objs[i].radius, i});
+    }
+    std::sort(intervals.begin(), intervals.end(),
+              [](const Interval& a, const Interval& b) { return a.minX < b.minX; });
+
+    parent.resize(n);
+    for (int i = 0; i < n; ++i) parent[i] = i;
+
+    for (size_t a = 0; a < intervals.size(); ++a) {
+        const Object& oa = objs[intervals[a].index];
+        for (size_t b = a + 1; b < intervals.size() && intervals[b].minX <= intervals[a].maxX; ++b) {
+            ++stats.candidates;
+            const Object& ob = objs[intervals[b].index];
+            if (!oa.Overlaps(ob)) continue;
+            ++stats.hits;
+            // La raíz de cada grupo es el cuerpo más pesado: conserva color y buffers
+            int ra = Find(intervals[a].index), rb = Find(intervals[b].index);
+            if (ra == rb) continue;
+            if (objs[rb].mass > objs[ra].mass) std::swap(ra, rb);
+            parent[rb] = ra;
+        }
+    }
+
+    if (stats.hits == 0) {
+        stats.ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+        return 0;
+    }
+
+    // Acumula masa, momento, centro de masa y volumen en cada raíz
+    std::vector<int> members(n, 0);
+    std::vector<double> mass(n, 0.0), volume(n, 0.0);
+    std::vector<glm::dvec3> momentum(n, glm::dvec3(0.0)), moment(n, glm::dvec3(0.0));
+    for (int i = 0; i < n; ++i) {
+        int r = Find(i);
+        const Object& o = objs[i];
+        ++members[r];
+        mass[r] += o.mass;
+        volume[r] += o.mass / o.density;
+        momentum[r] += glm::dvec3(o.velocity) * static_cast<double>(o.mass);
+        moment[r] += glm::dvec3(o.position) * static_cast<double>(o.mass);
+    }
+
+    for (int i = 0; i < n; ++i) {
+        if (Find(i) != i || members[i] == 1) continue;
+        Object& root = objs[i];
+        root.position = glm::vec3(moment[i] / mass[i]);
+        root.velocity = glm::vec3(momentum[i] / mass[i]);
+        root.mass = static_cast<float>(mass[i]);
+        root.density = static_cast<float>(mass[i] / volume[i]);
+        root.UpdateRadius();  // la instancia se escala sola: nada que re-subir
+    }
+
+    // Compacta objs en una pasada, descartando los cuerpos absorbidos
+    size_t write = 0;
+    for (int i = 0; i < n; ++i) {
+        if (Find(i) != i) {
+            ++stats.merged;
+            continue;
+        }
+        if (write != static_cast<size_t>(i)) objs[write] = objs[i];
+        ++write;
+    }
+    objs.erase(objs.begin() + write, objs.end());
+
+    stats.ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    return stats.merged;
+}
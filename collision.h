@@ -0,0 +1,36 @@
+// collision.h
+#pragma once
+#include <cstddef>
+#include <vector>
+#include "object.h"
+
+struct CollisionStats {
+    size_t candidates = 0;  // pares que pasan la fase amplia
+    size_t hits = 0;        // pares que realmente se tocan
+    size_t merged = 0;      // cuerpos absorbidos en este frame
+    double ms = 0.0;
+};
+
+// Colisiones en dos fases: sweep-and-prune en el eje x para sacar pares candidatos
+// en tiempo casi lineal y prueba de esferas sobre ellos. Los cuerpos que se tocan
+// se fusionan conservando masa y momento; todas las fusiones de un frame se
+// agrupan por componentes conexas y se aplican en una sola pasada sobre objs.
+class CollisionSystem {
+public:
+    // Devuelve cuántos cuerpos desaparecieron de objs
+    size_t Resolve(std::vector<Object>& objs);
+
+    const CollisionStats& Stats() const { return stats; }
+
+private:
+    struct Interval {
+        float minX, maxX;
+        int index;
+    };
+
+    std::vector<Interval> intervals;
+    std::vector<int> parent;  // union-find
+    CollisionStats stats;
+
+    int Find(int i);
+};
@@ -0,0 +1,32 @@
+// frustum.cpp
+#include "frustum.h"
+
+Frustum Frustum::FromMatrix(const glm::mat4& m) {
+    // glm guarda por columnas: la fila i es (m[0][i], m[1][i], m[2][i], m[3][i])
+    auto row = [&m](int i) { return glm::vec4(m[0][i], m[1][i], m[2][i], m[3][i]); };
+    Frustum f;
+    f.planes[0] = row(3) + row(0);
+    f.planes[1] = row(3) - row(0);
+    f.planes[2] = row(3) + row(1);
+    f.planes[3] = row(3) - row(1);
+    f.planes[4] = row(3) + row(2);
+    f.planes[5] = row(3) - row(2);
+    for (glm::vec4& p : f.planes) p /= glm::length(glm::vec3(p));
+    return f;
+}
+
+bool Frustum::SphereVisible(const glm::vec3& center, float radius) const {
+    for (const glm::vec4& p : planes) {
+        if (glm::dot(glm::vec3(p), center) + p.w < -radius) return false;
+    }
+    return true;
+}
+
+// Con el vértice de la caja más adelantado según la normal de cada plano
+bool Frustum::BoxVisible(const glm::vec3& min, const glm::vec3& max) const {
+    for (const glm::vec4& p : planes) {
+        glm::vec3 corner(p.x >= 0.0f ? max.x : min.x, p.y >= 0.0f ? max.y : min.y, p.z >= 0.0f ? max.z : min.z);
+        if (glm::dot(glm::vec3(p), corner) + p.w < 0.0f) return false;
+    }
+    return true;
+}
@@ -0,0 +1,17 @@
+// frustum.h
+#pragma once
+#include <glm/glm.hpp>
+
+// Los 6 planos de la pirámide de visión sacados de projection * view
+// (Gribb-Hartmann). Normales hacia dentro y normalizadas, así la distancia
+// de un punto al plano es directamente dot(n, p) + d.
+class Frustum {
+public:
+    static Frustum FromMatrix(const glm::mat4& viewProjection);
+
+    bool SphereVisible(const glm::vec3& center, float radius) const;
+    bool BoxVisible(const glm::vec3& min, const glm::vec3& max) const;
+
+private:
+    glm::vec4 planes[6];  // izquierda, derecha, abajo, arriba, cerca, lejos
+};
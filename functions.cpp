@@ -1,15 +1,18 @@
 #include "globals.h"
 #include "spaceship.h"
 #include "functions.h"
+#include "physics.h"
+#include "grid.h"
+#include "sim_thread.h"
+#include "recording.h"
 #include "object.h"  // Ahora sí necesitas la definición completa de Object aquí.
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
+#include <glm/gtc/constants.hpp>
 #include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
 #include <iostream>
 
-const double G = 6.6743e-11; // m^3 kg^-1 s^-2
-const float c = 299792458.0;
-
 struct InputActions {
     bool moveForward  = false;
     bool moveBack     = false;
@@ -23,13 +26,40 @@ struct InputActions {
 InputActions actions;
 
 extern Spaceship space;
-
-GLFWwindow* StartGLU() {
+extern Simulation sim;
+extern SpacetimeGrid grid;
+
+GLFWwindow* StartGLU(int width, int height, bool headless) {
+    if (headless) {
+        // Sin servidor gráfico: plataforma nula de GLFW 3.4 y contexto EGL u OSMesa
+        // (llvmpipe). La ventana no se muestra; se dibuja en un framebuffer propio.
+#ifdef GLFW_PLATFORM_NULL
+        glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+#endif
+    }
     if (!glfwInit()) {
         std::cout << "Failed to initialize GLFW, panic" << std::endl;
         return nullptr;
     }
-    GLFWwindow* window = glfwCreateWindow(800, 600, "3D_TEST", NULL, NULL);
+    GLFWwindow* window = nullptr;
+    if (headless) {
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+        glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+#ifdef GLFW_OSMESA_CONTEXT_API
+        glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_EGL_CONTEXT_API);
+        window = glfwCreateWindow(width, height, "3D_TEST", NULL, NULL);
+        if (!window) {
+            glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_OSMESA_CONTEXT_API);
+            window = glfwCreateWindow(width, height, "3D_TEST", NULL, NULL);
+        }
+#else
+        window = glfwCreateWindow(width, height, "3D_TEST", NULL, NULL);
+#endif
+    } else {
+        window = glfwCreateWindow(width, height, "3D_TEST", NULL, NULL);
+    }
     if (!window) {
         std::cerr << "Failed to create GLFW window." << std::endl;
         glfwTerminate();
@@ -38,21 +68,27 @@ GLFWwindow* StartGLU() {
     glfwMakeContextCurrent(window);
 
     glewExperimental = GL_TRUE;
-    if (glewInit() != GLEW_OK) {
+    GLenum glewStatus = glewInit();
+#ifdef GLEW_ERROR_NO_GLX_DISPLAY
+    // GLEW compilado para GLX se queja sin display, pero las funciones GL ya están cargadas
+    if (headless && glewStatus == GLEW_ERROR_NO_GLX_DISPLAY) glewStatus = GLEW_OK;
+#endif
+    if (glewStatus != GLEW_OK) {
         std::cerr << "Failed to initialize GLEW." << std::endl;
         glfwTerminate();
         return nullptr;
     }
 
     glEnable(GL_DEPTH_TEST);
-    glViewport(0, 0, 800, 600);
+    glViewport(0, 0, width, height);
     glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA); // Standard blending for transparency
 
     return window;
 }
 
-GLuint CreateShaderProgram(const char* vSrc, const char* fSrc) {
+GLuint CreateShaderProgram(const char* vSrc, const char* fSrc, bool retrievable,
+                           const char* feedbackVarying) {
     // Vertex shader
     GLuint vertexShader = glCreateShader(GL_VERTEX_SHADER);
     glShaderSource(vertexShader, 1, &vSrc, nullptr);
@@ -82,6 +118,8 @@ GLuint CreateShaderProgram(const char* vSrc, const char* fSrc) {
     GLuint shaderProgram = glCreateProgram();
     glAttachShader(shaderProgram, vertexShader);
     glAttachShader(shaderProgram, fragmentShader);
+    if (retrievable) glProgramParameteri(shaderProgram, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    if (feedbackVarying) glTransformFeedbackVaryings(shaderProgram, 1, &feedbackVarying, GL_INTERLEAVED_ATTRIBS);
     glLinkProgram(shaderProgram);
 
     glGetProgramiv(shaderProgram, GL_LINK_STATUS, &success);
@@ -110,18 +148,18 @@ void CreateVBOVAO(GLuint& VAO, GLuint& VBO, const float* vertices, size_t count)
     glBindVertexArray(0);
 }
 
-void UpdateCam(GLuint shader, const glm::vec3& camPos,
-               const glm::vec3& camFront, const glm::vec3& camUp)
-{ glUseProgram(shader);
+glm::mat4 UpdateCam(CameraBlock& camera, const glm::mat4& projection, const glm::vec3& camPos,
+                    const glm::vec3& camFront, const glm::vec3& camUp)
+{
     glm::mat4 view = glm::lookAt(camPos, camPos + camFront, camUp);
-    GLint viewLoc = glGetUniformLocation(shader, "view");
-    glUniformMatrix4fv(viewLoc, 1, GL_FALSE, glm::value_ptr(view));}
+    camera.Update(view, projection);
+    return view;
+}
 
-void DrawGrid(GLuint shader, GLuint VAO, size_t count) {
-    glUseProgram(shader);
+void DrawGrid(const ShaderProgram& shader, GLuint VAO, size_t count) {
+    shader.Use();
     glm::mat4 model = glm::mat4(1.0f); // Identity matrix for the grid
-    GLint modelLoc = glGetUniformLocation(shader, "model");
-    glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
+    glUniformMatrix4fv(shader.Uniform("model"), 1, GL_FALSE, glm::value_ptr(model));
 
     glBindVertexArray(VAO);
     glPointSize(5.0f);
@@ -229,6 +267,35 @@ std::vector<float> CreateGridVertices(float size, int divisions, const std::vect
     return vertices;
 }
 
+// Generación de esfera: triangulación UV
+std::vector<float> CreateSphereVertices(float r, int stacks, int sectors) {
+    std::vector<float> vertices;
+    vertices.reserve(stacks * sectors * 6 * 3);
+    for (int i = 0; i < stacks; ++i) {
+        float theta1 = glm::pi<float>() * i / stacks;
+        float theta2 = glm::pi<float>() * (i + 1) / stacks;
+        for (int j = 0; j < sectors; ++j) {
+            float phi1 = 2.0f * glm::pi<float>() * j / sectors;
+            float phi2 = 2.0f * glm::pi<float>() * (j + 1) / sectors;
+
+            glm::vec3 v1 = sphericalToCartesian(r, theta1, phi1);
+            glm::vec3 v2 = sphericalToCartesian(r, theta1, phi2);
+            glm::vec3 v3 = sphericalToCartesian(r, theta2, phi1);
+            glm::vec3 v4 = sphericalToCartesian(r, theta2, phi2);
+
+            // Triángulo 1
+            vertices.insert(vertices.end(), {v1.x, v1.y, v1.z,
+                                             v2.x, v2.y, v2.z,
+                                             v3.x, v3.y, v3.z});
+            // Triángulo 2
+            vertices.insert(vertices.end(), {v2.x, v2.y, v2.z,
+                                             v4.x, v4.y, v4.z,
+                                             v3.x, v3.y, v3.z});
+        }
+    }
+    return vertices;
+}
+
 glm::vec3 sphericalToCartesian(float r, float theta, float phi){
     float x = r * sin(theta) * cos(phi);
     float y = r * cos(theta);
@@ -237,9 +304,73 @@ glm::vec3 sphericalToCartesian(float r, float theta, float phi){
 };
 
 void keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods) {
-    space.ProcessKeyInput(key, action);
     if (key == GLFW_KEY_ESCAPE && action == GLFW_PRESS)
         running = false;
+
+    // G: malla en CPU / GPU (es del render: vale también reproduciendo)
+    if (key == GLFW_KEY_G && action == GLFW_PRESS) {
+        bool gpu = grid.Mode() == GridMode::Cpu;
+        grid.SetMode(gpu ? GridMode::Gpu : GridMode::Cpu);
+        std::cout << "Grid deformation: " << (gpu ? "GPU" : "CPU") << std::endl;
+    }
+
+    // Reproducción: izquierda/derecha velocidad (negativa = hacia atrás), abajo pausa,
+    // RePág/AvPág saltan 10 s, Inicio vuelve al principio
+    if (replayer.IsOpen()) {
+        if (action != GLFW_PRESS && action != GLFW_REPEAT) return;
+        if (key == GLFW_KEY_LEFT || key == GLFW_KEY_RIGHT) {
+            replayer.SetSpeed(replayer.Speed() + (key == GLFW_KEY_RIGHT ? 0.5 : -0.5));
+            std::cout << "Replay speed: " << replayer.Speed() << "x" << std::endl;
+        }
+        if (key == GLFW_KEY_DOWN) replayer.TogglePause();
+        if (key == GLFW_KEY_PAGE_UP || key == GLFW_KEY_PAGE_DOWN) {
+            double frames = 10.0 / replayer.TickSeconds();
+            replayer.SetPlayhead(replayer.Playhead() + (key == GLFW_KEY_PAGE_UP ? frames : -frames));
+        }
+        if (key == GLFW_KEY_HOME) replayer.SetPlayhead(0.0);
+        return;
+    }
+
+    // La nave y sim son del hilo de simulación: la entrada se le pasa como comando
+    simThread.Post([key, action] { space.ProcessKeyInput(key, action); });
+
+    // B: alterna suma directa / Barnes-Hut; [ y ]: ajustan theta
+    if (action == GLFW_PRESS || action == GLFW_REPEAT) {
+        if (key == GLFW_KEY_B) {
+            simThread.Post([] {
+                bool bh = sim.Config().forceMode == ForceMode::Direct;
+                sim.SetForceMode(bh ? ForceMode::BarnesHut : ForceMode::Direct);
+                std::cout << "Force mode: " << (bh ? "Barnes-Hut" : "direct") << std::endl;
+            });
+        }
+        // I: leapfrog -> Yoshida4 -> Hermite4 con pasos por bloques
+        if (key == GLFW_KEY_I) {
+            simThread.Post([] {
+                Integrator next = static_cast<Integrator>((static_cast<int>(sim.Config().integrator) + 1) % 3);
+                sim.SetIntegrator(next);
+                std::cout << "Integrator: " << IntegratorName(next) << std::endl;
+            });
+        }
+        if (key == GLFW_KEY_LEFT_BRACKET || key == GLFW_KEY_RIGHT_BRACKET) {
+            simThread.Post([key] {
+                float theta = sim.Config().theta + (key == GLFW_KEY_RIGHT_BRACKET ? 0.1f : -0.1f);
+                sim.SetTheta(std::max(0.0f, theta));
+                std::cout << "Barnes-Hut theta: " << sim.Config().theta << std::endl;
+            });
+        }
+        // , y .: aceleración del tiempo de las órbitas (/10, x10)
+        if (key == GLFW_KEY_COMMA || key == GLFW_KEY_PERIOD) {
+            simThread.Post([key] {
+                simThread.SetTimeWarp(simThread.TimeWarp() * (key == GLFW_KEY_PERIOD ? 10.0 : 0.1));
+                std::cout << "Orbit time warp: " << simThread.TimeWarp() << "x" << std::endl;
+            });
+        }
+        // F5 / F9: guardar / cargar snapshot rápido
+        if (key == GLFW_KEY_F5 && action == GLFW_PRESS)
+            simThread.Post([] { simThread.SaveSnapshot("quicksave.snap"); });
+        if (key == GLFW_KEY_F9 && action == GLFW_PRESS)
+            simThread.Post([] { simThread.LoadSnapshot("quicksave.snap"); });
+    }
 }
 
 void mouse_callback(GLFWwindow* window, double xpos, double ypos) {
@@ -265,15 +396,28 @@ void mouse_callback(GLFWwindow* window, double xpos, double ypos) {
     front.z = sin(glm::radians(yaw)) * cos(glm::radians(pitch));
     cameraFront = glm::normalize(front);
 }
+// Cuerpo que se está creando con el botón pulsado (solo lo tocan los comandos,
+// en el hilo de simulación). Por handle: si se fusiona antes de soltar, no se
+// lanza otro cuerpo por error.
+static ObjectHandle spawning;
+
 void mouseButtonCallback(GLFWwindow* window, int button, int action, int mods){
-    if (button == GLFW_MOUSE_BUTTON_LEFT){
+    if (button == GLFW_MOUSE_BUTTON_LEFT && !replayer.IsOpen()){
+        // objs es del hilo de simulación
         if (action == GLFW_PRESS){
-            objs.emplace_back(glm::vec3(0.0, 0.0, 0.0), glm::vec3(0.0f, 0.0f, 0.0f), initMass);
-            objs[objs.size()-1].Initalizing = true;
+            simThread.Post([mass = initMass] {
+                spawning = objs.Spawn(glm::vec3(0.0, 0.0, 0.0), glm::vec3(0.0f, 0.0f, 0.0f), mass);
+                objs.Get(spawning)->Initalizing = true;
+            });
         };
         if (action == GLFW_RELEASE){
-            objs[objs.size()-1].Initalizing = false;
-            objs[objs.size()-1].Launched = true;
+            simThread.Post([] {
+                Object* obj = objs.Get(spawning);
+                if (!obj) return;
+                obj->Initalizing = false;
+                obj->Launched = true;
+                spawning = ObjectHandle();
+            });
         };
     };
     // if (!objs.empty() && button == GLFW_MOUSE_BUTTON_RIGHT && objs[objs.size()-1].Initalizing) {
@@ -4,29 +4,36 @@
 #include <glm/glm.hpp>
 #include <vector>
 #include "object.h"
+#include "shader.h"
 // o, si solo necesitas referencia:
 class Object;
 
 
-// Inicialización de GLFW, GLEW y estado GL
-GLFWwindow* StartGLU();
+// Inicialización de GLFW, GLEW y estado GL (headless: sin display, ventana oculta)
+GLFWwindow* StartGLU(int width = 800, int height = 600, bool headless = false);
 
-// Compilación y linking de shaders
-GLuint CreateShaderProgram(const char* vSrc, const char* fSrc);
+// Compilación y linking de shaders (retrievable: permite glGetProgramBinary después;
+// feedbackVarying: salida del vertex shader que se captura con transform feedback)
+GLuint CreateShaderProgram(const char* vSrc, const char* fSrc, bool retrievable = false,
+                           const char* feedbackVarying = nullptr);
 
 // Creación de un VAO/VBO para datos de vértices (solo posición xyz)
 void CreateVBOVAO(GLuint& VAO, GLuint& VBO, const float* vertices, size_t count);
 
-// Actualización de la vista de cámara (uniform "view")
-void UpdateCam(GLuint shader, const glm::vec3& camPos,
-               const glm::vec3& camFront, const glm::vec3& camUp);
+// Actualización de la cámara (UBO "Camera"); devuelve la matriz de vista
+glm::mat4 UpdateCam(CameraBlock& camera, const glm::mat4& projection, const glm::vec3& camPos,
+                    const glm::vec3& camFront, const glm::vec3& camUp);
 
 // Dibuja una cuadrícula usando líneas
-void DrawGrid(GLuint shader, GLuint VAO, size_t count);
+void DrawGrid(const ShaderProgram& shader, GLuint VAO, size_t count);
 
 // Genera vértices para una cuadrícula con desplazamiento
 std::vector<float> CreateGridVertices(float size, int divisions, const std::vector<Object>& objs);
 
+// Esfera UV (triángulos sin indexar, xyz) para glDrawArrays; SphereRenderer usa
+// icosferas indexadas y esta queda como referencia de --mesh-report
+std::vector<float> CreateSphereVertices(float r, int stacks, int sectors);
+
 // Conversión esférica → cartesiana
 glm::vec3 sphericalToCartesian(float r, float theta, float phi);
 
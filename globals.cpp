@@ -1,10 +1,12 @@
 // globals.cpp
 #include "globals.h"
-std::vector<Object> objs;
+ObjectPool objs;
 glm::vec3 cameraPos = glm::vec3(0.0f, 1000.0f, 5000.0f);
 glm::vec3 cameraFront = glm::vec3(0.0f, 0.0f, -1.0f);
 glm::vec3 cameraUp = glm::vec3(0.0f, 1.0f, 0.0f);
 float lastX = 400.0f, lastY = 300.0f;
 float yaw = -90.0f, pitch = 0.0f, deltaTime = 0.0f, lastFrame = 0.0f, initMass = 1e20f;
-bool running = true, pause = false;
+std::atomic<bool> running{true}, paused{false};
 
+const double G = 6.6743e-11; // m^3 kg^-1 s^-2
+const float c = 299792458.0;
@@ -1,11 +1,17 @@
 // globals.h
 #pragma once
 #include <glm/glm.hpp>
+#include <atomic>
 #include <vector>
 #include "object.h"
+#include "object_pool.h"
 
-extern std::vector<Object> objs;
+extern ObjectPool objs;  // del hilo de simulación
 extern glm::vec3 cameraPos, cameraFront, cameraUp;
 extern float lastX, lastY, yaw, pitch, deltaTime, lastFrame;
-extern bool running, pause;
+extern std::atomic<bool> running, paused;  // también los lee el hilo de simulación
 extern float initMass;
+
+// Constantes físicas (SI)
+extern const double G;
+extern const float c;
@@ -0,0 +1,492 @@
+// grid.cpp
+#include "globals.h"
+#include "grid.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <random>
+
+// Misma transformación que CreateGridVertices con 50 divisiones:
+// plano en y = -9000 y altura final = (y + desplazamiento) / 15 - 3000
+static constexpr float PLANE_Y = -9000.0f;
+static constexpr float HEIGHT_SCALE = 1.0f / 15.0f;
+static constexpr float HEIGHT_OFFSET = -3000.0f;
+static constexpr size_t GRID_GRAIN = 4096;  // vértices por tarea del pool
+static constexpr size_t ADAPT_OPS_PER_FRAME = 256;  // divisiones/fusiones por refinado como mucho
+static constexpr int ADAPT_EVERY = 8;               // frames entre refinados (cada cambio resube la topología)
+
+// |h''(d)| de la altura final para un cuerpo: HEIGHT_SCALE * 200 * sqrt(1000 rs d)
+// derivada dos veces respecto a d (d en unidades, rs en metros)
+static float WellCurvature(float rs) {
+    return HEIGHT_SCALE * 200.0f * 0.25f * std::sqrt(1000.0f * rs);
+}
+
+static const char* gridVertexSrc = R"glsl(
+#version 330 core
+layout(location=0) in vec2 aXZ;
+layout(location=1) in float aY;
+)glsl" CAMERA_BLOCK_GLSL R"glsl(
+void main(){
+    gl_Position = projection * view * vec4(aXZ.x, aY, aXZ.y, 1.0);
+}
+)glsl";
+
+// Misma fórmula que GridDisplacement, por vértice, leyendo los cuerpos del UBO.
+// vHeight se captura con transform feedback para comparar con la CPU.
+static const char* gridGpuVertexSrc = R"glsl(
+#version 330 core
+layout(location=0) in vec2 aXZ;
+)glsl" CAMERA_BLOCK_GLSL R"glsl(
+layout(std140) uniform Bodies {
+    vec4 bodies[1024];   // xyz = posición, w = rs (m)
+};
+uniform int bodyCount;
+uniform vec3 heightParams;  // plano y, escala, desplazamiento
+out float vHeight;
+void main(){
+    vec3 p = vec3(aXZ.x, heightParams.x, aXZ.y);
+    float sum = 0.0;
+    for (int b = 0; b < bodyCount; ++b) {
+        float dm = length(bodies[b].xyz - p) * 1000.0;
+        float rs = bodies[b].w;
+        sum += sqrt(max(rs * (dm - rs), 0.0));
+    }
+    vHeight = (p.y + sum * 200.0) * heightParams.y + heightParams.z;
+    gl_Position = projection * view * vec4(aXZ.x, vHeight, aXZ.y, 1.0);
+}
+)glsl";
+
+static const char* gridFragmentSrc = R"glsl(
+#version 330 core
+out vec4 FragColor;
+uniform vec4 gridColor;
+void main(){
+    FragColor = gridColor;
+}
+)glsl";
+
+void SpacetimeGrid::SetupGL() {
+    simd = DetectSimdLevel();
+    program.Build(gridVertexSrc, gridFragmentSrc, "grid");
+    gpuProgram.Build(gridGpuVertexSrc, gridFragmentSrc, "grid_gpu", "vHeight");
+    gpuProgram.BindBlock("Bodies", GRID_BODIES_UBO_BINDING);
+    gpuProgram.Use();
+    glUniform3f(gpuProgram.Uniform("heightParams"), PLANE_Y, HEIGHT_SCALE, HEIGHT_OFFSET);
+
+    glGenBuffers(1, &bodiesUBO);
+    glBindBuffer(GL_UNIFORM_BUFFER, bodiesUBO);
+    glBufferData(GL_UNIFORM_BUFFER, MAX_GPU_BODIES * sizeof(glm::vec4), nullptr, GL_DYNAMIC_DRAW);
+    glBindBufferBase(GL_UNIFORM_BUFFER, GRID_BODIES_UBO_BINDING, bodiesUBO);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+    glGenVertexArrays(1, &VAO);
+    glBindVertexArray(VAO);
+
+    glGenBuffers(1, &xzVBO);
+    glBindBuffer(GL_ARRAY_BUFFER, xzVBO);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+
+    glGenBuffers(1, &yVBO);
+    glBindBuffer(GL_ARRAY_BUFFER, yVBO);
+    glVertexAttribPointer(1, 1, GL_FLOAT, GL_FALSE, sizeof(float), (void*)0);
+    glEnableVertexAttribArray(1);
+
+    glGenBuffers(1, &EBO);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+
+    glBindVertexArray(0);
+}
+
+// Sube x/z y los índices de la topología actual (vx, vz ya rellenos). Los segmentos
+// se ordenan por bloque para que cada bloque sea un rango contiguo del EBO.
+void SpacetimeGrid::UploadTopology(const std::vector<uint32_t>& indices) {
+    const size_t count = vx.size();
+    vy.assign(count, PLANE_Y);
+    height.assign(count, PLANE_Y * HEIGHT_SCALE + HEIGHT_OFFSET);
+    std::vector<float> xz(count * 2);
+    for (size_t i = 0; i < count; ++i) {
+        xz[2 * i] = vx[i];
+        xz[2 * i + 1] = vz[i];
+    }
+
+    const size_t segments = indices.size() / 2;
+    std::vector<int> tileOf(segments);
+    int perTile[TILES * TILES] = {};
+    for (Tile& t : tiles) {
+        t.min = glm::vec3(extent, 0.0f, extent);
+        t.max = glm::vec3(-extent, 0.0f, -extent);
+    }
+    for (size_t s = 0; s < segments; ++s) {
+        uint32_t a = indices[2 * s], b = indices[2 * s + 1];
+        float mx = 0.5f * (vx[a] + vx[b]) / extent + 0.5f;
+        float mz = 0.5f * (vz[a] + vz[b]) / extent + 0.5f;
+        int tx = std::clamp(static_cast<int>(mx * TILES), 0, TILES - 1);
+        int tz = std::clamp(static_cast<int>(mz * TILES), 0, TILES - 1);
+        int t = tz * TILES + tx;
+        tileOf[s] = t;
+        perTile[t]++;
+        // Caja con los extremos reales: un segmento puede asomar al bloque vecino
+        tiles[t].min.x = std::min({tiles[t].min.x, vx[a], vx[b]});
+        tiles[t].max.x = std::max({tiles[t].max.x, vx[a], vx[b]});
+        tiles[t].min.z = std::min({tiles[t].min.z, vz[a], vz[b]});
+        tiles[t].max.z = std::max({tiles[t].max.z, vz[a], vz[b]});
+    }
+    GLsizei first = 0;
+    for (int t = 0; t < TILES * TILES; ++t) {
+        tiles[t].first = first;
+        tiles[t].count = 2 * perTile[t];
+        first += tiles[t].count;
+    }
+    std::vector<uint32_t> sorted(indices.size());
+    std::vector<GLsizei> cursor(TILES * TILES);
+    for (int t = 0; t < TILES * TILES; ++t) cursor[t] = tiles[t].first;
+    for (size_t s = 0; s < segments; ++s) {
+        GLsizei& at = cursor[tileOf[s]];
+        sorted[at++] = indices[2 * s];
+        sorted[at++] = indices[2 * s + 1];
+    }
+
+    glBindVertexArray(VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, xzVBO);
+    glBufferData(GL_ARRAY_BUFFER, xz.size() * sizeof(float), xz.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, yVBO);
+    glBufferData(GL_ARRAY_BUFFER, height.size() * sizeof(float), height.data(), GL_STREAM_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sorted.size() * sizeof(uint32_t), sorted.data(), GL_STATIC_DRAW);
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+// Altura mínima y máxima de cada bloque sin mirar sus vértices: el desplazamiento
+// crece con la distancia, así que basta el punto más cercano y la esquina más lejana
+// de cada cuerpo. Vale igual para el modo CPU y el GPU.
+void SpacetimeGrid::UpdateTileBounds() {
+    auto displacement = [](float dist, float rs) {
+        return 200.0f * std::sqrt(std::max(rs * (dist * 1000.0f - rs), 0.0f));
+    };
+    for (Tile& t : tiles) {
+        float nearDisp = 0.0f, farDisp = 0.0f;
+        for (size_t b = 0; b < bx.size(); ++b) {
+            float dy = by[b] - PLANE_Y;
+            float nx = bx[b] - std::clamp(bx[b], t.min.x, t.max.x);
+            float nz = bz[b] - std::clamp(bz[b], t.min.z, t.max.z);
+            float fx = std::max(std::fabs(bx[b] - t.min.x), std::fabs(bx[b] - t.max.x));
+            float fz = std::max(std::fabs(bz[b] - t.min.z), std::fabs(bz[b] - t.max.z));
+            nearDisp += displacement(std::sqrt(nx * nx + dy * dy + nz * nz), brs[b]);
+            farDisp += displacement(std::sqrt(fx * fx + dy * dy + fz * fz), brs[b]);
+        }
+        t.min.y = (PLANE_Y + nearDisp) * HEIGHT_SCALE + HEIGHT_OFFSET;
+        t.max.y = (PLANE_Y + farDisp) * HEIGHT_SCALE + HEIGHT_OFFSET;
+    }
+}
+
+void SpacetimeGrid::Init(float size, int divisions) {
+    adaptive = false;
+    extent = size;
+    SetupGL();
+
+    const int side = divisions + 1;
+    const float step = size / divisions;
+    const float halfSize = size / 2.0f;
+    const size_t count = static_cast<size_t>(side) * side;
+
+    vx.resize(count); vz.resize(count);
+    for (int row = 0; row < side; ++row) {
+        for (int col = 0; col < side; ++col) {
+            size_t i = static_cast<size_t>(row) * side + col;
+            vx[i] = -halfSize + col * step;
+            vz[i] = -halfSize + row * step;
+        }
+    }
+
+    // Segmentos en x y en z entre vértices vecinos
+    std::vector<uint32_t> indices;
+    indices.reserve(static_cast<size_t>(4) * divisions * side);
+    for (int row = 0; row < side; ++row) {
+        for (int col = 0; col < divisions; ++col) {
+            uint32_t a = row * side + col;
+            indices.push_back(a); indices.push_back(a + 1);
+        }
+    }
+    for (int col = 0; col < side; ++col) {
+        for (int row = 0; row < divisions; ++row) {
+            uint32_t a = row * side + col;
+            indices.push_back(a); indices.push_back(a + side);
+        }
+    }
+    UploadTopology(indices);
+}
+
+void SpacetimeGrid::InitAdaptive(float size, int maxDepth, size_t vertexBudget) {
+    adaptive = true;
+    extent = size;
+    quadtree.Init(size, maxDepth, vertexBudget);
+    SetupGL();
+    // La topología se construye en el primer Update, cuando ya se conocen los cuerpos
+}
+
+void SpacetimeGrid::Destroy() {
+    glDeleteVertexArrays(1, &VAO);
+    glDeleteBuffers(1, &xzVBO);
+    glDeleteBuffers(1, &yVBO);
+    glDeleteBuffers(1, &EBO);
+    glDeleteBuffers(1, &bodiesUBO);
+    program.Destroy();
+    gpuProgram.Destroy();
+    VAO = xzVBO = yVBO = EBO = bodiesUBO = 0;
+}
+
+void SpacetimeGrid::GatherBodies(const std::vector<Object>& objs) {
+    const size_t nBodies = objs.size();
+    bx.resize(nBodies); by.resize(nBodies); bz.resize(nBodies); brs.resize(nBodies);
+    for (size_t b = 0; b < nBodies; ++b) {
+        bx[b] = objs[b].position.x;
+        by[b] = objs[b].position.y;
+        bz[b] = objs[b].position.z;
+        brs[b] = static_cast<float>((2 * G * objs[b].mass) / (c * c));
+    }
+}
+
+// Malla adaptativa: ajusta el quadtree a los cuerpos actuales y, si cambió, resube la topología
+void SpacetimeGrid::UpdateTopology() {
+    if (!adaptive) return;
+    wells.resize(bx.size());
+    for (size_t b = 0; b < bx.size(); ++b) wells[b] = {bx[b], by[b], bz[b], WellCurvature(brs[b])};
+
+    bool changed = true;
+    if (!quadtree.Fitted()) quadtree.Fit(wells.data(), wells.size(), PLANE_Y);
+    else if (++framesSinceRefine < ADAPT_EVERY) return;
+    else changed = quadtree.Refine(wells.data(), wells.size(), PLANE_Y, ADAPT_OPS_PER_FRAME);
+    framesSinceRefine = 0;
+    if (!changed) return;
+
+    std::vector<uint32_t> indices;
+    quadtree.Emit(vx, vz, indices);
+    UploadTopology(indices);
+    ++topologyRebuilds;
+}
+
+void SpacetimeGrid::ComputeHeights(ThreadPool& pool) {
+    const size_t count = vx.size();
+    const size_t nBodies = bx.size();
+    pool.ParallelFor(count, GRID_GRAIN, [&](size_t begin, size_t end) {
+        GridDisplacement(simd, vx.data(), vy.data(), vz.data(), begin, end,
+                         bx.data(), by.data(), bz.data(), brs.data(), nBodies, height.data());
+        for (size_t i = begin; i < end; ++i)
+            height[i] = (vy[i] + height[i]) * HEIGHT_SCALE + HEIGHT_OFFSET;
+    });
+}
+
+void SpacetimeGrid::UploadBodies() {
+    gpuBodyCount = static_cast<int>(bx.size());
+    std::vector<glm::vec4> packed(gpuBodyCount);
+    for (int b = 0; b < gpuBodyCount; ++b) packed[b] = glm::vec4(bx[b], by[b], bz[b], brs[b]);
+    glBindBuffer(GL_UNIFORM_BUFFER, bodiesUBO);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, packed.size() * sizeof(glm::vec4), packed.data());
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+void SpacetimeGrid::Update(const std::vector<Object>& objs, ThreadPool& pool) {
+    GatherBodies(objs);
+    UpdateTopology();
+    UpdateTileBounds();
+
+    // En GPU solo viajan los cuerpos; si no caben en el UBO, este frame va por CPU
+    // (el modo pedido se mantiene y se vuelve a la GPU en cuanto quepan)
+    const bool fits = bx.size() <= static_cast<size_t>(MAX_GPU_BODIES);
+    if (mode == GridMode::Gpu && fits) {
+        activeMode = GridMode::Gpu;
+        fallbackLogged = false;
+        UploadBodies();
+        return;
+    }
+    if (mode == GridMode::Gpu && !fallbackLogged) {
+        std::cerr << "Grid: " << bx.size() << " bodies exceed the GPU limit of "
+                  << MAX_GPU_BODIES << ", falling back to CPU" << std::endl;
+        fallbackLogged = true;
+    }
+    activeMode = GridMode::Cpu;
+
+    ComputeHeights(pool);
+
+    // Orphaning: el buffer viejo sigue vivo para los draws en vuelo y escribimos en uno nuevo
+    const size_t count = vx.size();
+    glBindBuffer(GL_ARRAY_BUFFER, yVBO);
+    glBufferData(GL_ARRAY_BUFFER, count * sizeof(float), nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, count * sizeof(float), height.data());
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+bool SpacetimeGrid::CompareGpuToCpu(const std::vector<Object>& objs, ThreadPool& pool, float tolerance) {
+    GatherBodies(objs);
+    UpdateTopology();
+    if (bx.size() > static_cast<size_t>(MAX_GPU_BODIES)) {
+        std::cerr << "Grid check: too many bodies for the GPU path" << std::endl;
+        return false;
+    }
+    UploadBodies();
+    ComputeHeights(pool);
+
+    // Un punto por vértice, sin rasterizar: solo interesa vHeight
+    const size_t count = vx.size();
+    GLuint feedback = 0;
+    glGenBuffers(1, &feedback);
+    glBindBuffer(GL_TRANSFORM_FEEDBACK_BUFFER, feedback);
+    glBufferData(GL_TRANSFORM_FEEDBACK_BUFFER, count * sizeof(float), nullptr, GL_STATIC_READ);
+    glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, feedback);
+
+    gpuProgram.Use();
+    glUniform1i(gpuProgram.Uniform("bodyCount"), gpuBodyCount);
+    glEnable(GL_RASTERIZER_DISCARD);
+    glBindVertexArray(VAO);
+    glBeginTransformFeedback(GL_POINTS);
+    glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(count));
+    glEndTransformFeedback();
+    glBindVertexArray(0);
+    glDisable(GL_RASTERIZER_DISCARD);
+
+    std::vector<float> gpuHeight(count);
+    glGetBufferSubData(GL_TRANSFORM_FEEDBACK_BUFFER, 0, count * sizeof(float), gpuHeight.data());
+    glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, 0);
+    glDeleteBuffers(1, &feedback);
+
+    // Error relativo a la magnitud de la altura (nunca cerca de 0: el plano está en -3600)
+    float maxErr = 0.0f;
+    size_t worst = 0;
+    for (size_t i = 0; i < count; ++i) {
+        float err = std::fabs(gpuHeight[i] - height[i]) / std::max(std::fabs(height[i]), 1.0f);
+        if (err > maxErr) { maxErr = err; worst = i; }
+    }
+    bool pass = maxErr <= tolerance;
+    std::cout << "Grid GPU vs CPU: " << count << " vertices, " << gpuBodyCount << " bodies, max rel err "
+              << maxErr << " (vertex " << worst << ": gpu " << gpuHeight[worst] << ", cpu " << height[worst]
+              << ") " << (pass ? "ok" : "FAIL") << std::endl;
+    return pass;
+}
+
+void SpacetimeGrid::Submit(RenderQueue& queue, const Frustum& frustum) {
+    const ShaderProgram& active = activeMode == GridMode::Gpu ? gpuProgram : program;
+    material.program = &active;
+    material.apply = [this, &active] {
+        if (activeMode == GridMode::Gpu) glUniform1i(active.Uniform("bodyCount"), gpuBodyCount);
+        glUniform4f(active.Uniform("gridColor"), 0.6f, 0.6f, 0.8f, 0.35f);
+    };
+
+    // Un paquete por rango de bloques visibles; los contiguos en el EBO se juntan.
+    // La malla envuelve la escena: profundidad 0 para que salga la última, como antes.
+    DrawPacket packet;
+    packet.material = &material;
+    packet.vao = VAO;
+    packet.mode = GL_LINES;
+    packet.indexType = GL_UNSIGNED_INT;
+    packet.layer = RenderLayer::Transparent;
+    packet.count = 0;
+    visibleTiles = 0;
+    for (const Tile& t : tiles) {
+        if (t.count == 0 || !frustum.BoxVisible(t.min, t.max)) continue;
+        ++visibleTiles;
+        if (packet.count > 0 && static_cast<GLuint>(t.first) == packet.first + packet.count) {
+            packet.count += static_cast<GLuint>(t.count);
+            continue;
+        }
+        queue.Submit(packet);  // el vacío del principio no entra
+        packet.first = static_cast<GLuint>(t.first);
+        packet.count = static_cast<GLuint>(t.count);
+    }
+    queue.Submit(packet);
+}
+
+// Altura exacta en (x, z) con el mismo kernel que la malla
+static float ExactHeight(float x, float z, const std::vector<float>& bx, const std::vector<float>& by,
+                         const std::vector<float>& bz, const std::vector<float>& brs) {
+    float y = PLANE_Y, disp = 0.0f;
+    GridDisplacement(SimdLevel::Scalar, &x, &y, &z, 0, 1, bx.data(), by.data(), bz.data(), brs.data(),
+                     bx.size(), &disp);
+    return (PLANE_Y + disp) * HEIGHT_SCALE + HEIGHT_OFFSET;
+}
+
+// Interpolación bilineal de la celda [x0, x0+s] x [z0, z0+s] a partir de sus esquinas
+static float CellHeight(float x, float z, float x0, float z0, float s, const std::vector<float>& bx,
+                        const std::vector<float>& by, const std::vector<float>& bz, const std::vector<float>& brs) {
+    float u = (x - x0) / s, v = (z - z0) / s;
+    float h00 = ExactHeight(x0, z0, bx, by, bz, brs), h10 = ExactHeight(x0 + s, z0, bx, by, bz, brs);
+    float h01 = ExactHeight(x0, z0 + s, bx, by, bz, brs), h11 = ExactHeight(x0 + s, z0 + s, bx, by, bz, brs);
+    return (h00 * (1 - u) + h10 * u) * (1 - v) + (h01 * (1 - u) + h11 * u) * v;
+}
+
+void PrintAdaptiveGridReport() {
+    const float size = 100000.0f;
+    const int uniformDivisions = 1000;
+    const int maxDepth = 10;  // celda mínima ~98 unidades, como la uniforme
+    const size_t uniformVertices = static_cast<size_t>(uniformDivisions + 1) * (uniformDivisions + 1);
+    const size_t budget = uniformVertices / 20;
+
+    // Escena inicial de main: Luna y Tierra
+    std::vector<Object> scene;
+    scene.emplace_back(glm::vec3(3844.0f, 0.0f, 0.0f), glm::vec3(0.0f), static_cast<float>(7.34767309e22), 3344.0f);
+    scene.emplace_back(glm::vec3(0.0f), glm::vec3(0.0f), static_cast<float>(5.97219e24), 5515.0f);
+    std::vector<float> bx, by, bz, brs;
+    std::vector<GridWell> wells;
+    for (const Object& o : scene) {
+        float rs = static_cast<float>((2 * G * o.mass) / (c * c));
+        bx.push_back(o.position.x); by.push_back(o.position.y); bz.push_back(o.position.z); brs.push_back(rs);
+        wells.push_back({o.position.x, o.position.y, o.position.z, WellCurvature(rs)});
+    }
+
+    GridQuadtree tree;
+    tree.Init(size, maxDepth, budget);
+    auto t0 = std::chrono::steady_clock::now();
+    tree.Fit(wells.data(), wells.size(), PLANE_Y);
+    auto t1 = std::chrono::steady_clock::now();
+    std::vector<float> vx, vz;
+    std::vector<uint32_t> indices;
+    tree.Emit(vx, vz, indices);
+    auto t2 = std::chrono::steady_clock::now();
+
+    // Un paso de la Luna (~1 frame) y refinado incremental
+    wells[0].x += 2.0f; wells[0].z += 50.0f;
+    auto t3 = std::chrono::steady_clock::now();
+    tree.Refine(wells.data(), wells.size(), PLANE_Y, ADAPT_OPS_PER_FRAME);
+    auto t4 = std::chrono::steady_clock::now();
+    wells[0].x -= 2.0f; wells[0].z -= 50.0f;
+    tree.Fit(wells.data(), wells.size(), PLANE_Y);
+
+    std::cout << "uniform " << uniformDivisions << "x" << uniformDivisions << ": " << uniformVertices
+              << " vertices" << std::endl;
+    std::cout << "adaptive depth " << maxDepth << ": " << vx.size() << " vertices ("
+              << 100.0 * vx.size() / uniformVertices << "%), " << indices.size() / 2 << " segments, "
+              << tree.LeafCount() << " cells, tolerance " << tree.Tolerance() << std::endl;
+    std::cout << "fit " << std::chrono::duration<double, std::milli>(t1 - t0).count() << " ms, emit "
+              << std::chrono::duration<double, std::milli>(t2 - t1).count() << " ms, incremental refine "
+              << std::chrono::duration<double, std::milli>(t4 - t3).count() << " ms" << std::endl;
+
+    // Error de interpolación frente a la altura exacta: cerca de los pozos y en todo el plano
+    const float uStep = size / uniformDivisions;
+    std::mt19937 rng(7u);
+    std::cout << "region\tsamples\tuniform_max\tuniform_rms\tadaptive_max\tadaptive_rms" << std::endl;
+    for (float radius : {15000.0f, size / 2.0f}) {
+        std::uniform_real_distribution<float> dist(-radius, radius);
+        const int samples = 100000;
+        double uMax = 0.0, uSq = 0.0, aMax = 0.0, aSq = 0.0;
+        for (int k = 0; k < samples; ++k) {
+            float x = dist(rng), z = dist(rng);
+            float exact = ExactHeight(x, z, bx, by, bz, brs);
+
+            float ux0 = -size / 2 + std::min(std::floor((x + size / 2) / uStep), uniformDivisions - 1.0f) * uStep;
+            float uz0 = -size / 2 + std::min(std::floor((z + size / 2) / uStep), uniformDivisions - 1.0f) * uStep;
+            double eu = std::fabs(CellHeight(x, z, ux0, uz0, uStep, bx, by, bz, brs) - exact);
+
+            GridQuadtree::Cell cell = tree.FindCell(x, z);
+            double ea = std::fabs(CellHeight(x, z, cell.x0, cell.z0, cell.size, bx, by, bz, brs) - exact);
+
+            uMax = std::max(uMax, eu); uSq += eu * eu;
+            aMax = std::max(aMax, ea); aSq += ea * ea;
+        }
+        std::cout << (radius < size / 2.0f ? "wells" : "plane") << "\t" << samples << "\t"
+                  << uMax << "\t" << std::sqrt(uSq / samples) << "\t"
+                  << aMax << "\t" << std::sqrt(aSq / samples) << std::endl;
+    }
+}
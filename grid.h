@@ -0,0 +1,93 @@
+// grid.h
+#pragma once
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <vector>
+#include "frustum.h"
+#include "object.h"
+#include "quadtree.h"
+#include "render_queue.h"
+#include "shader.h"
+#include "simd_gravity.h"
+#include "thread_pool.h"
+
+// Dónde se calcula la deformación: en CPU (SIMD + hilos, sube y cada frame) o en
+// el vertex shader a partir de un UBO con los cuerpos (la malla plana se sube una vez)
+enum class GridMode { Cpu, Gpu };
+
+// Malla espacio-temporal que se deforma cada frame con la posición actual de objs.
+// Los vértices son únicos (retícula (div+1)^2 indexada con GL_LINES) y se guardan
+// en SoA: x/z fijos en un VBO estático y la altura y en un VBO dinámico que se
+// deja huérfano antes de cada subida, así la GPU nunca bloquea la escritura.
+class SpacetimeGrid {
+public:
+    static constexpr int MAX_GPU_BODIES = 1024;  // 16 KB de vec4: el mínimo garantizado de un UBO
+
+    void Init(float size, int divisions);
+    // Malla adaptativa: quadtree de hasta maxDepth niveles (celda mínima size/2^maxDepth)
+    // refinado alrededor de los pozos, con unos vertexBudget vértices
+    void InitAdaptive(float size, int maxDepth, size_t vertexBudget);
+    void Destroy();
+
+    // Recalcula las alturas (multihilo + SIMD) y las sube a la GPU
+    void Update(const std::vector<Object>& objs, ThreadPool& pool);
+    // Envía solo los bloques de la malla que caen dentro del frustum
+    void Submit(RenderQueue& queue, const Frustum& frustum);
+
+    void SetMode(GridMode m) { mode = m; }
+    GridMode Mode() const { return mode; }
+
+    // Evalúa el shader con transform feedback y lo compara con el kernel de CPU.
+    // Devuelve true si el error relativo máximo es <= tolerance.
+    bool CompareGpuToCpu(const std::vector<Object>& objs, ThreadPool& pool, float tolerance = 1e-3f);
+
+    size_t VertexCount() const { return vx.size(); }
+    size_t TopologyRebuilds() const { return topologyRebuilds; }
+    int VisibleTiles() const { return visibleTiles; }
+    int TileCount() const { return TILES * TILES; }
+    const std::vector<float>& Heights() const { return height; }
+
+private:
+    static constexpr int TILES = 8;  // bloques por lado para el culling
+
+    // Rango del EBO con los segmentos cuyo punto medio cae en el bloque, y su caja
+    struct Tile {
+        GLsizei first = 0, count = 0;
+        glm::vec3 min = glm::vec3(0.0f), max = glm::vec3(0.0f);
+    };
+    Tile tiles[TILES * TILES];
+    float extent = 0.0f;
+    int visibleTiles = 0;
+
+    std::vector<float> vx, vy, vz;  // posiciones sin deformar
+    std::vector<float> height;      // y final por vértice
+    std::vector<float> bx, by, bz, brs;  // cuerpos en SoA (rs = 2GM/c^2)
+
+    ShaderProgram program;     // CPU: y viene del VBO dinámico
+    ShaderProgram gpuProgram;  // GPU: y se calcula en el vertex shader
+    RenderMaterial material;   // el programa del modo activo
+    GLuint VAO = 0, xzVBO = 0, yVBO = 0, EBO = 0, bodiesUBO = 0;
+    SimdLevel simd = SimdLevel::Scalar;
+    GridMode mode = GridMode::Cpu;        // el pedido (tecla G)
+    GridMode activeMode = GridMode::Cpu;  // el del último Update: CPU si los cuerpos no caben en el UBO
+    bool fallbackLogged = false;
+    int gpuBodyCount = 0;
+
+    bool adaptive = false;
+    GridQuadtree quadtree;
+    std::vector<GridWell> wells;
+    size_t topologyRebuilds = 0;
+    int framesSinceRefine = 0;
+
+    void SetupGL();
+    void UploadTopology(const std::vector<uint32_t>& indices);
+    void UpdateTileBounds();
+    void UpdateTopology();
+    void GatherBodies(const std::vector<Object>& objs);
+    void ComputeHeights(ThreadPool& pool);
+    void UploadBodies();
+};
+
+// Compara la malla adaptativa (Tierra/Luna de la escena inicial) con una uniforme
+// de 1000x1000: vértices y error de interpolación de la altura (--grid-report)
+void PrintAdaptiveGridReport();
@@ -0,0 +1,232 @@
+// icosphere.cpp
+#include "icosphere.h"
+#include "functions.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <unordered_map>
+
+// Vértice normalizado a la esfera unitaria; devuelve su índice
+static uint32_t AddUnitVertex(std::vector<float>& vertices, float x, float y, float z) {
+    float inv = 1.0f / std::sqrt(x * x + y * y + z * z);
+    vertices.insert(vertices.end(), {x * inv, y * inv, z * inv});
+    return static_cast<uint32_t>(vertices.size() / 3 - 1);
+}
+
+// Subdivisión tal cual, con los triángulos en el orden en que salen
+static IndexedMesh SubdivideIcosahedron(int subdivisions) {
+    IndexedMesh mesh;
+    subdivisions = std::max(subdivisions, 0);
+    const size_t faces = size_t(20) << (2 * subdivisions);
+    mesh.vertices.reserve((faces / 2 + 2) * 3);
+
+    // Icosaedro: rectángulos áureos en los tres planos coordenados
+    const float t = (1.0f + std::sqrt(5.0f)) * 0.5f;
+    const float base[12][3] = {
+        {-1, t, 0}, {1, t, 0}, {-1, -t, 0}, {1, -t, 0},
+        {0, -1, t}, {0, 1, t}, {0, -1, -t}, {0, 1, -t},
+        {t, 0, -1}, {t, 0, 1}, {-t, 0, -1}, {-t, 0, 1},
+    };
+    for (const auto& v : base) AddUnitVertex(mesh.vertices, v[0], v[1], v[2]);
+    mesh.indices = {
+        0, 11, 5,  0, 5, 1,   0, 1, 7,   0, 7, 10,  0, 10, 11,
+        1, 5, 9,   5, 11, 4,  11, 10, 2, 10, 7, 6,  7, 1, 8,
+        3, 9, 4,   3, 4, 2,   3, 2, 6,   3, 6, 8,   3, 8, 9,
+        4, 9, 5,   2, 4, 11,  6, 2, 10,  8, 6, 7,   9, 8, 1,
+    };
+
+    // Cada arista se parte una sola vez: el punto medio se comparte entre sus dos caras
+    std::unordered_map<uint64_t, uint32_t> midpoints;
+    auto midpoint = [&](uint32_t a, uint32_t b) {
+        uint64_t key = (uint64_t(std::min(a, b)) << 32) | std::max(a, b);
+        auto it = midpoints.find(key);
+        if (it != midpoints.end()) return it->second;
+        const float* va = &mesh.vertices[a * 3];
+        const float* vb = &mesh.vertices[b * 3];
+        uint32_t index = AddUnitVertex(mesh.vertices, va[0] + vb[0], va[1] + vb[1], va[2] + vb[2]);
+        midpoints.emplace(key, index);
+        return index;
+    };
+    for (int s = 0; s < subdivisions; ++s) {
+        std::vector<uint32_t> next;
+        next.reserve(mesh.indices.size() * 4);
+        midpoints.clear();
+        midpoints.reserve(mesh.indices.size());
+        for (size_t i = 0; i < mesh.indices.size(); i += 3) {
+            uint32_t a = mesh.indices[i], b = mesh.indices[i + 1], c = mesh.indices[i + 2];
+            uint32_t ab = midpoint(a, b), bc = midpoint(b, c), ca = midpoint(c, a);
+            next.insert(next.end(), {a, ab, ca, b, bc, ab, c, ca, bc, ab, bc, ca});
+        }
+        mesh.indices.swap(next);
+    }
+    return mesh;
+}
+
+IndexedMesh CreateIcosphere(int subdivisions) {
+    IndexedMesh mesh = SubdivideIcosahedron(subdivisions);
+    OptimizeVertexCache(mesh.indices, mesh.VertexCount());
+    OptimizeVertexFetch(mesh);
+    return mesh;
+}
+
+// Parámetros de Forsyth: caché LRU simulada de 32, los tres últimos vértices
+// usados con puntuación fija y un extra para los vértices con pocos triángulos
+// pendientes (así no se quedan islas sueltas para el final)
+static constexpr int SCORE_CACHE_SIZE = 32;
+static constexpr float CACHE_DECAY_POWER = 1.5f;
+static constexpr float LAST_TRI_SCORE = 0.75f;
+static constexpr float VALENCE_BOOST_SCALE = 2.0f;
+static constexpr float VALENCE_BOOST_POWER = 0.5f;
+
+static float VertexScore(int cachePosition, uint32_t remaining) {
+    if (remaining == 0) return -1.0f;  // ya no sirve de nada
+    float score = 0.0f;
+    if (cachePosition >= 0) {
+        if (cachePosition < 3) {
+            score = LAST_TRI_SCORE;
+        } else {
+            float scaler = 1.0f / (SCORE_CACHE_SIZE - 3);
+            score = std::pow(1.0f - (cachePosition - 3) * scaler, CACHE_DECAY_POWER);
+        }
+    }
+    return score + VALENCE_BOOST_SCALE * std::pow(static_cast<float>(remaining), -VALENCE_BOOST_POWER);
+}
+
+void OptimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount) {
+    const size_t triCount = indices.size() / 3;
+    if (triCount == 0) return;
+
+    // Triángulos de cada vértice en CSR (offset + lista)
+    std::vector<uint32_t> remaining(vertexCount, 0), offset(vertexCount + 1, 0), adjacency(indices.size());
+    for (uint32_t v : indices) remaining[v]++;
+    for (size_t v = 0; v < vertexCount; ++v) offset[v + 1] = offset[v] + remaining[v];
+    std::vector<uint32_t> fill(offset.begin(), offset.end() - 1);
+    for (size_t i = 0; i < indices.size(); ++i) adjacency[fill[indices[i]]++] = static_cast<uint32_t>(i / 3);
+
+    std::vector<float> vertexScore(vertexCount), triScore(triCount, 0.0f);
+    std::vector<unsigned char> emitted(triCount, 0);
+    for (size_t v = 0; v < vertexCount; ++v) vertexScore[v] = VertexScore(-1, remaining[v]);
+    for (size_t t = 0; t < triCount; ++t)
+        for (int k = 0; k < 3; ++k) triScore[t] += vertexScore[indices[t * 3 + k]];
+
+    std::vector<uint32_t> output;
+    output.reserve(indices.size());
+    std::vector<uint32_t> cache, nextCache;
+    cache.reserve(SCORE_CACHE_SIZE + 3);
+    nextCache.reserve(SCORE_CACHE_SIZE + 3);
+
+    size_t scan = 0;  // primer triángulo que podría seguir sin emitir
+    int64_t best = -1;
+    while (output.size() < indices.size()) {
+        if (best < 0) {
+            // Sin candidatos en la caché: el mejor de los que quedan (solo al
+            // empezar y al saltar a una isla nueva, así que el barrido es barato)
+            float bestScore = -1.0f;
+            while (scan < triCount && emitted[scan]) ++scan;
+            for (size_t t = scan; t < triCount; ++t) {
+                if (!emitted[t] && triScore[t] > bestScore) { bestScore = triScore[t]; best = static_cast<int64_t>(t); }
+            }
+        }
+        const size_t tri = static_cast<size_t>(best);
+        emitted[tri] = 1;
+
+        // Los tres vértices pasan al frente de la LRU y dejan de contar este triángulo
+        nextCache.clear();
+        for (int k = 0; k < 3; ++k) {
+            uint32_t v = indices[tri * 3 + k];
+            output.push_back(v);
+            nextCache.push_back(v);
+            uint32_t* list = &adjacency[offset[v]];
+            uint32_t* end = list + remaining[v];
+            std::swap(*std::find(list, end, static_cast<uint32_t>(tri)), *(end - 1));
+            remaining[v]--;
+        }
+        for (uint32_t v : cache)
+            if (std::find(nextCache.begin(), nextCache.begin() + 3, v) == nextCache.begin() + 3) nextCache.push_back(v);
+
+        // Nuevas posiciones y puntuaciones; lo que sale por detrás se queda fuera
+        for (size_t i = 0; i < nextCache.size(); ++i) {
+            uint32_t v = nextCache[i];
+            int pos = i < static_cast<size_t>(SCORE_CACHE_SIZE) ? static_cast<int>(i) : -1;
+            float score = VertexScore(pos, remaining[v]);
+            float delta = score - vertexScore[v];
+            vertexScore[v] = score;
+            for (uint32_t j = 0; j < remaining[v]; ++j) triScore[adjacency[offset[v] + j]] += delta;
+        }
+        if (nextCache.size() > static_cast<size_t>(SCORE_CACHE_SIZE)) nextCache.resize(SCORE_CACHE_SIZE);
+        cache.swap(nextCache);
+
+        // El siguiente, entre los triángulos pendientes de los vértices en caché
+        best = -1;
+        float bestScore = -1.0f;
+        for (uint32_t v : cache) {
+            for (uint32_t j = 0; j < remaining[v]; ++j) {
+                uint32_t t = adjacency[offset[v] + j];
+                if (triScore[t] > bestScore) { bestScore = triScore[t]; best = t; }
+            }
+        }
+    }
+    indices.swap(output);
+}
+
+void OptimizeVertexFetch(IndexedMesh& mesh) {
+    const uint32_t UNSET = 0xFFFFFFFFu;
+    std::vector<uint32_t> remap(mesh.VertexCount(), UNSET);
+    std::vector<float> vertices;
+    vertices.reserve(mesh.vertices.size());
+    for (uint32_t& index : mesh.indices) {
+        if (remap[index] == UNSET) {
+            remap[index] = static_cast<uint32_t>(vertices.size() / 3);
+            vertices.insert(vertices.end(), mesh.vertices.begin() + index * 3, mesh.vertices.begin() + index * 3 + 3);
+        }
+        index = remap[index];
+    }
+    mesh.vertices.swap(vertices);  // los vértices que ningún triángulo usa se descartan
+}
+
+double ComputeACMR(const std::vector<uint32_t>& indices, size_t vertexCount, size_t cacheSize) {
+    if (indices.size() < 3) return 0.0;
+    // FIFO: un vértice está en caché si entró hace menos de cacheSize fallos
+    const size_t UNSET = ~size_t(0);
+    std::vector<size_t> entered(vertexCount, UNSET);
+    size_t misses = 0;
+    for (uint32_t v : indices) {
+        if (entered[v] == UNSET || misses - entered[v] >= cacheSize) {
+            entered[v] = misses++;
+        }
+    }
+    return static_cast<double>(misses) / (indices.size() / 3);
+}
+
+void PrintMeshReport() {
+    // Mismos pares de niveles que SphereRenderer: antes esfera UV de n x n segmentos,
+    // ahora icosfera con s subdivisiones
+    const int uvSegments[] = {36, 24, 16, 10, 6};
+    const int subdivisions[] = {4, 3, 2, 1, 0};
+    const size_t cacheSizes[] = {16, 32};
+
+    std::cout << "mesh\tvertices\tindices\ttriangles\tbytes\tACMR/16\tACMR/32\tshaded/mesh" << std::endl;
+    for (int level = 0; level < 5; ++level) {
+        // Sopa sin indexar: cada vértice se transforma en cada triángulo (ACMR 3)
+        const size_t uvVertices = CreateSphereVertices(1.0f, uvSegments[level], uvSegments[level]).size() / 3;
+        std::cout << "uv " << uvSegments[level] << "x" << uvSegments[level] << "\t" << uvVertices << "\t0\t"
+                  << uvVertices / 3 << "\t" << uvVertices * 3 * sizeof(float) << "\t3\t3\t" << uvVertices << std::endl;
+
+        IndexedMesh mesh = CreateIcosphere(subdivisions[level]);
+        const size_t bytes = mesh.vertices.size() * sizeof(float) + mesh.indices.size() * sizeof(uint16_t);
+        double acmr[2];
+        for (int c = 0; c < 2; ++c) acmr[c] = ComputeACMR(mesh.indices, mesh.VertexCount(), cacheSizes[c]);
+        std::cout << "ico s" << subdivisions[level] << "\t" << mesh.VertexCount() << "\t" << mesh.indices.size()
+                  << "\t" << mesh.TriangleCount() << "\t" << bytes << "\t" << acmr[0] << "\t" << acmr[1] << "\t"
+                  << static_cast<size_t>(acmr[0] * mesh.TriangleCount()) << std::endl;
+    }
+
+    // Cuánto aporta el reordenado: la misma icosfera en el orden de la subdivisión
+    IndexedMesh raw = SubdivideIcosahedron(4);
+    std::vector<uint32_t> optimized = raw.indices;
+    OptimizeVertexCache(optimized, raw.VertexCount());
+    for (size_t cache : cacheSizes) {
+        std::cout << "ico s4 ACMR/" << cache << " in subdivision order: " << ComputeACMR(raw.indices, raw.VertexCount(), cache)
+                  << ", optimized: " << ComputeACMR(optimized, raw.VertexCount(), cache) << std::endl;
+    }
+}
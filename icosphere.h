@@ -0,0 +1,37 @@
+// icosphere.h
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Malla indexada: xyz por vértice y tres índices por triángulo
+struct IndexedMesh {
+    std::vector<float> vertices;
+    std::vector<uint32_t> indices;
+
+    size_t VertexCount() const { return vertices.size() / 3; }
+    size_t TriangleCount() const { return indices.size() / 3; }
+};
+
+// Icosaedro subdividido `subdivisions` veces (cada triángulo en cuatro, puntos
+// medios llevados a la esfera): 20 * 4^s triángulos, 10 * 4^s + 2 vértices,
+// todos compartidos y casi equiláteros, sin polos degenerados. La esfera es
+// unitaria y centrada: la posición sirve también de normal. Sale con los
+// índices optimizados para la caché de vértices y los vértices en orden de uso.
+IndexedMesh CreateIcosphere(int subdivisions);
+
+// Reordena los triángulos para aprovechar la caché post-transformación
+// (puntuación por posición en una LRU simulada y valencia pendiente, Forsyth).
+void OptimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount);
+
+// Renumera los vértices por orden de primera aparición en los índices, para que
+// la lectura del VBO sea lo más secuencial posible
+void OptimizeVertexFetch(IndexedMesh& mesh);
+
+// Vértices transformados por triángulo con una caché FIFO de `cacheSize`
+// entradas (3.0 = sin reutilización, como una malla sin indexar)
+double ComputeACMR(const std::vector<uint32_t>& indices, size_t vertexCount, size_t cacheSize);
+
+// Esfera UV sin indexar frente a la icosfera: vértices, índices, ACMR y memoria
+// de cada nivel de detalle de SphereRenderer (--mesh-report)
+void PrintMeshReport();
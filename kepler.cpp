@@ -0,0 +1,74 @@
+// kepler.cpp
+#include "kepler.h"
+#include <algorithm>
+#include <cmath>
+
+static constexpr double PI = 3.14159265358979323846;
+static constexpr double DEG = PI / 180.0;
+static constexpr int MAX_ITERATIONS = 12;
+static constexpr double TOLERANCE = 1e-14;
+
+OrbitalElements ElementsFromJ2000(double aAu, double e, double iDeg, double meanLongDeg,
+                                  double periLongDeg, double nodeDeg, double mu) {
+    OrbitalElements el;
+    el.a = aAu * AU_KM;
+    el.e = e;
+    el.i = iDeg * DEG;
+    el.node = nodeDeg * DEG;
+    el.peri = (periLongDeg - nodeDeg) * DEG;
+    el.M0 = (meanLongDeg - periLongDeg) * DEG;
+    el.n = std::sqrt(mu / (el.a * el.a * el.a));
+    return el;
+}
+
+void SolveKepler(const double* M, const double* e, double* E, size_t n) {
+    // Arranque E = M + e sin M; con e alta converge mejor desde pi
+    for (size_t k = 0; k < n; ++k)
+        E[k] = e[k] > 0.8 ? (M[k] < 0.0 ? -PI : PI) : M[k] + e[k] * std::sin(M[k]);
+    for (int it = 0; it < MAX_ITERATIONS; ++it) {
+        double maxStep = 0.0;
+        for (size_t k = 0; k < n; ++k) {
+            double step = (E[k] - e[k] * std::sin(E[k]) - M[k]) / (1.0 - e[k] * std::cos(E[k]));
+            E[k] -= step;
+            maxStep = std::max(maxStep, std::abs(step));
+        }
+        if (maxStep < TOLERANCE) break;
+    }
+}
+
+size_t KeplerOrbits::Add(const OrbitalElements& el) {
+    const double cw = std::cos(el.peri), sw = std::sin(el.peri);
+    const double cn = std::cos(el.node), sn = std::sin(el.node);
+    const double ci = std::cos(el.i), si = std::sin(el.i);
+    // P y Q en la eclíptica; a la escena como (x, z, -y) para que y sea el polo
+    const double Px = cw * cn - sw * sn * ci, Py = cw * sn + sw * cn * ci, Pz = sw * si;
+    const double Qx = -sw * cn - cw * sn * ci, Qy = -sw * sn + cw * cn * ci, Qz = cw * si;
+    px.push_back(Px); py.push_back(Pz); pz.push_back(-Py);
+    qx.push_back(Qx); qy.push_back(Qz); qz.push_back(-Qy);
+    a.push_back(el.a);
+    b.push_back(el.a * std::sqrt(1.0 - el.e * el.e));
+    e.push_back(el.e);
+    n.push_back(el.n);
+    M0.push_back(el.M0);
+    return a.size() - 1;
+}
+
+void KeplerOrbits::Clear() {
+    for (auto* v : {&a, &b, &e, &n, &M0, &px, &py, &pz, &qx, &qy, &qz, &M, &E, &x, &y, &z}) v->clear();
+}
+
+void KeplerOrbits::Evaluate(double t) {
+    const size_t count = a.size();
+    M.resize(count); E.resize(count);
+    x.resize(count); y.resize(count); z.resize(count);
+    // Anomalía media reducida a [-pi, pi] en doble: sin deriva con t grande
+    for (size_t k = 0; k < count; ++k) M[k] = std::remainder(M0[k] + n[k] * t, 2.0 * PI);
+    SolveKepler(M.data(), e.data(), E.data(), count);
+    for (size_t k = 0; k < count; ++k) {
+        double u = a[k] * (std::cos(E[k]) - e[k]);
+        double v = b[k] * std::sin(E[k]);
+        x[k] = u * px[k] + v * qx[k];
+        y[k] = u * py[k] + v * qy[k];
+        z[k] = u * pz[k] + v * qz[k];
+    }
+}
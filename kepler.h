@@ -0,0 +1,53 @@
+// kepler.h
+#pragma once
+#include <cstddef>
+#include <vector>
+
+constexpr double GM_SUN = 1.32712440018e11;  // km^3/s^2
+constexpr double AU_KM = 149597870.7;
+constexpr double J2000_JD = 2451545.0;      // época de los elementos (día juliano)
+constexpr double SECONDS_PER_DAY = 86400.0;
+
+// Elementos keplerianos clásicos (ángulos en radianes)
+struct OrbitalElements {
+    double a = 0.0;     // semieje mayor (km)
+    double e = 0.0;     // excentricidad (< 1)
+    double i = 0.0;     // inclinación sobre la eclíptica
+    double node = 0.0;  // longitud del nodo ascendente
+    double peri = 0.0;  // argumento del periapsis
+    double M0 = 0.0;    // anomalía media en J2000
+    double n = 0.0;     // movimiento medio (rad/s)
+};
+
+// Desde la tabla de elementos medios J2000 de JPL: a en UA, ángulos en grados,
+// longitud media L y longitud del perihelio varpi (M0 = L - varpi, peri = varpi - node)
+OrbitalElements ElementsFromJ2000(double aAu, double e, double iDeg, double meanLongDeg,
+                                  double periLongDeg, double nodeDeg, double mu = GM_SUN);
+
+// Ecuación de Kepler M = E - e sin E para n órbitas a la vez (Newton en doble,
+// bucles planos sobre arrays para que el compilador los vectorice)
+void SolveKepler(const double* M, const double* e, double* E, size_t n);
+
+// Conjunto de órbitas en SoA. Evaluate(t) da la posición de todas en tiempo
+// constante para cualquier t: saltar a una fecha o acelerar el tiempo 10^6 veces
+// cuesta lo mismo que avanzar un frame, y no se acumula error de paso.
+class KeplerOrbits {
+public:
+    size_t Add(const OrbitalElements& el);
+    size_t Size() const { return a.size(); }
+    void Clear();
+
+    // t en segundos desde J2000; posiciones en km con los ejes de la escena
+    // (x = equinoccio, y = polo norte de la eclíptica)
+    void Evaluate(double t);
+    const std::vector<double>& X() const { return x; }
+    const std::vector<double>& Y() const { return y; }
+    const std::vector<double>& Z() const { return z; }
+
+private:
+    std::vector<double> a, b, e, n, M0;  // b = a * sqrt(1 - e^2)
+    std::vector<double> px, py, pz;      // P: hacia el periapsis
+    std::vector<double> qx, qy, qz;      // Q: 90 grados por delante en el plano orbital
+    std::vector<double> M, E;            // temporales
+    std::vector<double> x, y, z;
+};
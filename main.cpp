@@ -3,16 +3,33 @@
 #include "planet.h"
 #include "functions.h"
 #include "spaceship.h"
+#include "physics.h"
+#include "collision.h"
+#include "icosphere.h"
+#include "sphere_renderer.h"
+#include "grid.h"
+#include "trail_renderer.h"
+#include "belt.h"
+#include "particle_renderer.h"
+#include "render_queue.h"
+#include "offscreen.h"
+#include "profiler.h"
+#include "sim_thread.h"
+#include "recording.h"
+#include "thread_pool.h"
 #include <GL/glew.h>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <thread>
 
 const char* vertexSrc = R"glsl(
 #version 330 core
 layout(location=0) in vec3 aPos;
 uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+)glsl" CAMERA_BLOCK_GLSL R"glsl(
 void main(){
     gl_Position = projection * view * model * vec4(aPos, 1.0);
 }
@@ -28,31 +45,144 @@ void main(){
 )glsl";
 
 Spaceship space;
+Simulation sim;
+SpacetimeGrid grid;
 
 
-int main() {
+int main(int argc, char** argv) {
 
-    GLFWwindow* window = StartGLU();
+    // Modos sin ventana
+    bool gridCheck = false;
+    bool indirectDraws = true;  // --no-mdi: la cola dibuja sin glMultiDraw*Indirect
+    int width = 800, height = 600;
+    int headlessFrames = 0;          // > 0: renderiza N frames sin display y sale
+    float fixedDeltaTime = 1.0f / 60.0f;
+    std::string frameOutput;         // patrón PPM o "-" (rgb24 a stdout)
+    std::string tracePath, csvPath;  // export del profiler al salir
+    double startJulianDay = J2000_JD;  // fecha inicial de las órbitas
+    std::string loadPath, savePath;    // snapshot a cargar al arrancar / guardar al salir
+    std::string recordPath, replayPath;  // grabar la trayectoria / reproducir una sin simular
+    size_t beltCount = 100000, ringCount = 50000;  // partículas de prueba (0 = sin cinturón / anillos)
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]) == "--bh-report") {
+            PrintForceAccuracyReport();
+            return 0;
+        }
+        if (std::string(argv[i]) == "--simd-check") {
+            return SimdSelfCheck() ? 0 : 1;
+        }
+        if (std::string(argv[i]) == "--scaling-report") {
+            PrintThreadScalingReport();
+            return 0;
+        }
+        if (std::string(argv[i]) == "--integrator-report") {
+            PrintIntegratorReport();
+            return 0;
+        }
+        if (std::string(argv[i]) == "--mesh-report") {
+            PrintMeshReport();
+            return 0;
+        }
+        if (std::string(argv[i]) == "--grid-report") {
+            PrintAdaptiveGridReport();
+            return 0;
+        }
+        if (std::string(argv[i]) == "--grid-check") {
+            gridCheck = true;
+        }
+        if (std::string(argv[i]) == "--no-mdi") {
+            indirectDraws = false;
+        }
+        if (std::string(argv[i]) == "--headless" && i + 1 < argc) {
+            headlessFrames = std::max(1, std::stoi(argv[++i]));
+        }
+        if (std::string(argv[i]) == "--size" && i + 1 < argc) {
+            std::string size = argv[++i];
+            size_t x = size.find('x');
+            if (x != std::string::npos) {
+                width = std::max(1, std::stoi(size.substr(0, x)));
+                height = std::max(1, std::stoi(size.substr(x + 1)));
+            }
+        }
+        if (std::string(argv[i]) == "--dt" && i + 1 < argc) {
+            fixedDeltaTime = std::stof(argv[++i]);
+        }
+        if (std::string(argv[i]) == "--out" && i + 1 < argc) {
+            frameOutput = argv[++i];
+        }
+        if (std::string(argv[i]) == "--trace" && i + 1 < argc) {
+            tracePath = argv[++i];
+        }
+        if (std::string(argv[i]) == "--profile-csv" && i + 1 < argc) {
+            csvPath = argv[++i];
+        }
+        if (std::string(argv[i]) == "--jd" && i + 1 < argc) {
+            startJulianDay = std::stod(argv[++i]);
+        }
+        if (std::string(argv[i]) == "--warp" && i + 1 < argc) {
+            simThread.SetTimeWarp(std::stod(argv[++i]));
+        }
+        if (std::string(argv[i]) == "--load" && i + 1 < argc) {
+            loadPath = argv[++i];
+        }
+        if (std::string(argv[i]) == "--save" && i + 1 < argc) {
+            savePath = argv[++i];
+        }
+        if (std::string(argv[i]) == "--record" && i + 1 < argc) {
+            recordPath = argv[++i];
+        }
+        if (std::string(argv[i]) == "--replay" && i + 1 < argc) {
+            replayPath = argv[++i];
+        }
+        if (std::string(argv[i]) == "--belt" && i + 1 < argc) {
+            beltCount = std::stoul(argv[++i]);
+        }
+        if (std::string(argv[i]) == "--rings" && i + 1 < argc) {
+            ringCount = std::stoul(argv[++i]);
+        }
+        if (std::string(argv[i]) == "--threads" && i + 1 < argc) {
+            sim.SetThreadCount(static_cast<unsigned>(std::stoul(argv[++i])));
+        }
+    }
+
+    const bool headless = headlessFrames > 0;
+    FrameWriter writer;
+    if (headless && !frameOutput.empty() && !writer.Open(frameOutput)) return -1;
+    // Con los frames en stdout, los logs van a stderr
+    if (writer.ToStdout()) std::cout.rdbuf(std::cerr.rdbuf());
+
+    GLFWwindow* window = StartGLU(width, height, headless);
     if (!window) return -1;
 
-    space.createModel();
+    OffscreenTarget target;
+    if (headless && !target.Init(width, height)) {
+        glfwTerminate();
+        return -1;
+    }
 
-    glfwSetKeyCallback(window, keyCallback);
-    glfwSetCursorPosCallback(window, mouse_callback);
-    glfwSetMouseButtonCallback(window, mouseButtonCallback);
-    glfwSetScrollCallback(window, scroll_callback);
+    space.createModel();
 
-    GLuint shader = CreateShaderProgram(vertexSrc, fragmentSrc);
-    glUseProgram(shader);
+    if (!headless) {
+        glfwSetKeyCallback(window, keyCallback);
+        glfwSetCursorPosCallback(window, mouse_callback);
+        glfwSetMouseButtonCallback(window, mouseButtonCallback);
+        glfwSetScrollCallback(window, scroll_callback);
+    }
 
-    GLint modelLoc      = glGetUniformLocation(shader, "model");
-    GLint projectionLoc = glGetUniformLocation(shader, "projection");
+    // Programa principal (uniforms cacheados, binario en shader_cache/) y UBO de cámara
+    ShaderProgram shader;
+    if (!shader.Build(vertexSrc, fragmentSrc, "main")) {
+        shader.Destroy();
+        glfwTerminate();
+        return -1;
+    }
+    CameraBlock camera;
+    camera.Init();
 
     // Matriz de proyección
     glm::mat4 projection = glm::perspective(
-        glm::radians(45.0f), 800.0f / 600.0f, 0.1f, 750000.0f
+        glm::radians(45.0f), static_cast<float>(width) / height, 0.1f, 750000.0f
     );
-    glUniformMatrix4fv(projectionLoc, 1, GL_FALSE, glm::value_ptr(projection));
 
     // --- Constantes de escala ---
     const float ORBIT_SCALE = 1.0f / 3e12f;  // Disminuye distancias orbitales
@@ -73,73 +203,301 @@ bodies.emplace_back(glm::vec3(0.0f), 1426666422.0f * ORBIT_SCALE, 5.68e26f, 687.
 bodies.emplace_back(glm::vec3(0.0f), 2870658186.0f * ORBIT_SCALE, 8.68e25f, 1271.0f, glm::vec4(0.4f, 0.8f, 1.0f, 1.0f)); // Urano
 bodies.emplace_back(glm::vec3(0.0f), 4498396441.0f * ORBIT_SCALE, 1.02e26f, 1638.0f, glm::vec4(0.3f, 0.5f, 1.0f, 1.0f)); // Neptuno
 
-// Asignar velocidades de órbita (radianes por segundo aprox., no realistas)
-bodies[1].SetOrbitSpeed(glm::radians(50.0f)); // Mercurio
-bodies[2].SetOrbitSpeed(glm::radians(30.0f)); // Venus
-bodies[3].SetOrbitSpeed(glm::radians(20.0f)); // Tierra
-bodies[4].SetOrbitSpeed(glm::radians(15.0f)); // Marte
-bodies[5].SetOrbitSpeed(glm::radians(5.0f));  // Júpiter
-bodies[6].SetOrbitSpeed(glm::radians(3.0f));  // Saturno
-bodies[7].SetOrbitSpeed(glm::radians(2.0f));  // Urano
-bodies[8].SetOrbitSpeed(glm::radians(1.0f));  // Neptuno
+// Órbitas keplerianas: elementos medios J2000 de JPL (a en UA, e, i, L, varpi, nodo en grados).
+// Sustituyen al radio orbital del constructor: la posición sale de los elementos.
+bodies[1].SetOrbit(ElementsFromJ2000(0.38709927, 0.20563593, 7.00497902, 252.25032350, 77.45779628, 48.33076593), ORBIT_SCALE);   // Mercurio
+bodies[2].SetOrbit(ElementsFromJ2000(0.72333566, 0.00677672, 3.39467605, 181.97909950, 131.60246718, 76.67984255), ORBIT_SCALE);  // Venus
+bodies[3].SetOrbit(ElementsFromJ2000(1.00000261, 0.01671123, -0.00001531, 100.46457166, 102.93768193, 0.0), ORBIT_SCALE);         // Tierra
+bodies[4].SetOrbit(ElementsFromJ2000(1.52371034, 0.09339410, 1.84969142, -4.55343205, -23.94362959, 49.55953891), ORBIT_SCALE);   // Marte
+bodies[5].SetOrbit(ElementsFromJ2000(5.20288700, 0.04838624, 1.30439695, 34.39644051, 14.72847983, 100.47390909), ORBIT_SCALE);   // Júpiter
+bodies[6].SetOrbit(ElementsFromJ2000(9.53667594, 0.05386179, 2.48599187, 49.95424423, 92.59887831, 113.66242448), ORBIT_SCALE);   // Saturno
+bodies[7].SetOrbit(ElementsFromJ2000(19.18916464, 0.04725744, 0.77263783, 313.23810451, 170.95427630, 74.01692503), ORBIT_SCALE); // Urano
+bodies[8].SetOrbit(ElementsFromJ2000(30.06992276, 0.00859048, 1.77004347, -55.12002969, 44.96476227, 131.78422574), ORBIT_SCALE); // Neptuno
+
 
+    // --- CINTURÓN Y ANILLOS (partículas sin masa, evaluadas en el render) ---
+    // El cinturón lleva su propia escala (1 UA = 10000 unidades): con ORBIT_SCALE las
+    // órbitas de los planetas quedan dentro del Sol. Los anillos, en radios de Saturno.
+    ParticleBelt belt;
+    if (beltCount > 0) belt.Generate(MainBeltParams(beltCount, 1.0e4 / AU_KM));
+    if (ringCount > 0) belt.Generate(SaturnRingParams(ringCount, 6, bodies[6].GetScaledRadius() / SATURN_RADIUS_KM));
 
     // --- OBJETOS GLOBALES ---
-    objs.clear();
+    objs.Clear();
     // Ejemplo: Luna y Tierra como objetos simulados
-    objs.emplace_back(glm::vec3(3844.0f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, 228.0f), static_cast<float>(7.34767309e22), 3344.0f);
-    objs.emplace_back(glm::vec3(0.0f), glm::vec3(0.0f), static_cast<float>(5.97219e24), 5515.0f);
+    objs.Spawn(glm::vec3(3844.0f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, 228.0f), static_cast<float>(7.34767309e22), 3344.0f);
+    objs.Spawn(glm::vec3(0.0f), glm::vec3(0.0f), static_cast<float>(5.97219e24), 5515.0f);
+
+    // --- GRID (se deforma cada frame con los objs actuales) ---
+    // Quadtree de 10 niveles (celda mínima como una malla de 1000x1000) con ~5% de sus vértices
+    grid.InitAdaptive(100000.0f, 10, 50000);
+    if (gridCheck) {
+        // Compara la deformación del vertex shader con la de CPU y sale
+        bool ok = grid.CompareGpuToCpu(objs.Dense(), sim.Pool());
+        grid.Destroy();
+        shader.Destroy();
+        camera.Destroy();
+        glfwTerminate();
+        return ok ? 0 : 1;
+    }
 
-    // --- GRID ---
-    GLuint gridVAO, gridVBO;
-    std::vector<float> gridVertices = CreateGridVertices(100000.0f, 50, objs);
-    CreateVBOVAO(gridVAO, gridVBO, gridVertices.data(), gridVertices.size());
+    // --- ESFERAS (malla compartida, dibujo instanciado) ---
+    SphereRenderer spheres;
+    // --- ESTELAS (anillo por cuerpo en un buffer persistente) ---
+    TrailRenderer trails;
+    ParticleRenderer particles;
+    if (!spheres.Init() || !trails.Init() || !particles.Init()) {
+        spheres.Destroy();
+        trails.Destroy();
+        particles.Destroy();
+        shader.Destroy();
+        camera.Destroy();
+        grid.Destroy();
+        glfwTerminate();
+        return -1;
+    }
+    particles.SetColors(belt.Colors());
+    // --- COLA DE DIBUJO (ordena y agrupa los paquetes de todos los renderers) ---
+    RenderQueue queue;
+    queue.Init(indirectDraws);
+
+    // --- SIMULACIÓN ---
+    // Con ventana va en su propio hilo a paso fijo; sin ventana, ticks a mano
+    // para que la salida sea reproducible
+    simThread.SetPlanets(std::move(bodies));
+    simThread.SeekOrbits((startJulianDay - J2000_JD) * SECONDS_PER_DAY);
+    // Un snapshot sustituye a la escena de arriba (cuerpos, planetas y relojes)
+    if (!loadPath.empty() && !simThread.LoadSnapshot(loadPath)) {
+        spheres.Destroy();
+        trails.Destroy();
+        particles.Destroy();
+        queue.Destroy();
+        shader.Destroy();
+        camera.Destroy();
+        grid.Destroy();
+        glfwTerminate();
+        return -1;
+    }
+    std::cout << "[sim] force kernel: " << SimdLevelName(sim.GetSimdLevel())
+              << ", threads: " << sim.Pool().ThreadCount() << std::endl;
+    // Reproduciendo no se simula: solo decodificar y dibujar
+    const bool replaying = !replayPath.empty();
+    if (replaying && !replayer.Open(replayPath)) {
+        spheres.Destroy();
+        trails.Destroy();
+        particles.Destroy();
+        queue.Destroy();
+        shader.Destroy();
+        camera.Destroy();
+        grid.Destroy();
+        glfwTerminate();
+        return -1;
+    }
+    if (!replaying) {
+        if (!recordPath.empty()) simThread.StartRecording(recordPath);
+        if (headless) simThread.Tick();
+        else simThread.Start();
+    }
+
+    // La malla y el cinturón se evalúan en el hilo de render: pool propio (ParallelFor
+    // no admite dos hilos llamando a la vez), más pequeño para no pelear con el de la física
+    ThreadPool gridPool(std::max(1u, std::thread::hardware_concurrency() / 4));
+    RenderState state;
+    std::vector<unsigned char> planetLod, objLod;  // histéresis de LOD (objs por hueco del pool)
+    // Estela de cada hueco del pool y de quién es: si el hueco cambia de dueño o
+    // se queda vacío, la estela se borra. Reproduciendo no hay handles: se usa el índice
+    std::vector<ObjectHandle> trailOwners;
+    std::vector<unsigned char> trailSeen;
+    auto objKey = [&](size_t i) {
+        const ObjectHandle h = state.objs[i].handle;
+        return h.Valid() ? h : ObjectHandle{static_cast<uint32_t>(i), 0};
+    };
+    float lastStatsPrint = 0.0f;
+
+    int frameIndex = 0;
+    std::vector<unsigned char> pixels;
 
     while (!glfwWindowShouldClose(window) && running) {
         // Tiempo
-        float currentFrame = glfwGetTime();
-        deltaTime = currentFrame - lastFrame;
+        profiler.BeginFrame();
+        float currentFrame = headless ? frameIndex * fixedDeltaTime : static_cast<float>(glfwGetTime());
+        deltaTime = headless ? fixedDeltaTime : currentFrame - lastFrame;
         lastFrame = currentFrame;
+        if (headless) target.Bind();
 
         // Limpieza y eventos
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-        glfwPollEvents();
+        {
+            PROFILE_SCOPE("input");
+            glfwPollEvents();
+        }
 
-        // Actualizar nave y cámara
-        space.Update(deltaTime);
-        cameraPos = space.position + glm::vec3(0.0f, 50.0f, 150.0f);
-        cameraFront = glm::normalize(space.direction);
-        glm::mat4 view = glm::lookAt(cameraPos, cameraPos + cameraFront, cameraUp);
-        GLint viewLoc = glGetUniformLocation(shader, "view");
-        glUniformMatrix4fv(viewLoc, 1, GL_FALSE, glm::value_ptr(view));
+        // Último estado publicado, interpolado entre los dos últimos ticks
+        if (replaying) {
+            PROFILE_SCOPE("replay");
+            replayer.Advance(deltaTime);
+        } else if (headless) {
+            PROFILE_SCOPE("physics");
+            simThread.RunFor(deltaTime);
+        }
+        const WorldSnapshot& world = replaying ? replayer.Snapshot() : simThread.Acquire();
+        {
+            PROFILE_SCOPE("interpolate");
+            float alpha = replaying ? replayer.Alpha() : simThread.Alpha(world);
+            SimThread::Interpolate(world, alpha, state);
+        }
+        if (currentFrame - lastStatsPrint > 2.0f) {
+            const SimStats& st = world.stats;
+            std::cout << "[sim] bodies=" << st.bodies
+                      << " steps/s=" << st.stepsPerSecond
+                      << " step=" << st.lastStepMs << " ms"
+                      << " collision candidates=" << world.collisionCandidates
+                      << " tick=" << world.tick << std::endl;
+            std::cout << "[sim] orbits JD=" << J2000_JD + world.orbitTime / SECONDS_PER_DAY
+                      << " warp=" << world.timeWarp << "x" << std::endl;
+            // Utilización de cada hilo del pool en la última ventana
+            std::cout << "[sim] thread util:";
+            for (double util : world.threadUtil)
+                std::cout << " " << static_cast<int>(util * 100.0) << "%";
+            std::cout << std::endl;
+            std::cout << "[render] sphere triangles: " << spheres.Stats().trianglesSubmitted
+                      << " with LOD / " << spheres.Stats().trianglesFull << " without" << std::endl;
+            std::cout << "[render] grid vertices: " << grid.VertexCount()
+                      << " topology rebuilds: " << grid.TopologyRebuilds() << std::endl;
+            std::cout << "[render] visible spheres: " << spheres.InstanceCount()
+                      << " culled: " << spheres.Stats().culled
+                      << ", grid tiles: " << grid.VisibleTiles() << "/" << grid.TileCount() << std::endl;
+            std::cout << "[render] belt particles: " << particles.Count() << std::endl;
+            std::cout << "[render] trails: " << trails.ActiveTrails() << " active ("
+                      << (trails.Persistent() ? "persistent" : "orphaned") << ")" << std::endl;
+            const RenderQueueStats& rq = queue.Stats();
+            std::cout << "[render] queue: " << rq.packets << " packets, " << rq.drawCalls << " draw calls ("
+                      << rq.multiDraws << (queue.Indirect() ? " indirect" : " multi") << "), "
+                      << rq.programBinds << " programs, " << rq.vaoBinds << " VAOs, " << rq.stateChanges
+                      << " state changes / " << rq.apiCalls << " GL calls (per renderer: "
+                      << rq.unsortedStateChanges << " / " << rq.unsortedApiCalls << ")" << std::endl;
+            lastStatsPrint = currentFrame;
+        }
 
-        // Dibujar objetos
-        for (auto& planet : bodies) {
-            planet.UpdateAnimation(deltaTime);
-            glm::mat4 model = planet.GetModelMatrix();
-            GLint viewLoc = glGetUniformLocation(shader, "view");
-            glUniformMatrix4fv(viewLoc, 1, GL_FALSE, glm::value_ptr(view));
-            planet.Draw(shader);
+        // Matrices: cámara e instancias (una por cuerpo, con culling y LOD)
+        glm::mat4 view;
+        {
+            PROFILE_SCOPE("matrices");
+            cameraPos = state.shipPosition + glm::vec3(0.0f, 50.0f, 150.0f);
+            cameraFront = glm::normalize(state.shipDirection);
+            view = UpdateCam(camera, projection, cameraPos, cameraFront, cameraUp);
+            spheres.Begin(cameraPos, projection, view, static_cast<float>(height));
+            planetLod.resize(state.planets.size());
+            for (size_t i = 0; i < state.planets.size(); ++i)
+                spheres.Add(state.planets[i], state.planetColors[i], &planetLod[i]);
+            for (size_t i = 0; i < state.objs.size(); ++i) {
+                const uint32_t slot = objKey(i).index;
+                if (slot >= objLod.size()) objLod.resize(slot + 1, 0);
+                spheres.Add(state.objs[i].GetModelMatrix(), state.objs[i].color, &objLod[slot]);
+            }
         }
 
-        // Dibujar nave
-        space.Draw(shader);
+        // Planetas y objetos: un paquete por nivel de detalle
+        {
+            PROFILE_SCOPE("submit spheres");
+            spheres.Submit(queue);
+        }
 
-        glfwSwapBuffers(window);
-    }
+        // Cinturón y anillos: Kepler para todas las partículas, escrito directo en el buffer mapeado
+        {
+            PROFILE_SCOPE("belt.Evaluate");
+            float *x, *y, *z;
+            if (particles.Map(x, y, z)) {
+                belt.Evaluate(state.orbitTime, state.planets, gridPool, x, y, z);
+                particles.Unmap();
+            }
+        }
+        // Cinturón y nave
+        particles.Submit(queue, projection[1][1] * height * 0.5f, glm::length(cameraPos));
+        space.Submit(queue, shader, state.shipPosition, state.shipDirection, cameraPos);
 
+        // Estelas: planetas 0..P-1, nave P y objs a partir de P+1
+        {
+            PROFILE_SCOPE("trails.Push");
+            const size_t planetCount = state.planets.size();
+            const float now = static_cast<float>(world.simTime);
+            for (size_t i = 0; i < planetCount; ++i)
+                trails.Push(i, glm::vec3(state.planets[i][3]), state.planetColors[i], now);
+            trails.Push(planetCount, state.shipPosition, glm::vec4(0.6f, 0.8f, 1.0f, 1.0f), now);
+            trailSeen.assign(trailOwners.size(), 0);
+            for (size_t i = 0; i < state.objs.size(); ++i) {
+                const ObjectHandle key = objKey(i);
+                if (key.index >= trailOwners.size()) {
+                    trailOwners.resize(key.index + 1);
+                    trailSeen.resize(key.index + 1, 0);
+                }
+                if (trailOwners[key.index] != key) {
+                    trails.Clear(planetCount + 1 + key.index);
+                    trailOwners[key.index] = key;
+                }
+                trailSeen[key.index] = 1;
+                trails.Push(planetCount + 1 + key.index, state.objs[i].position, state.objs[i].color, now);
+            }
+            for (size_t slot = 0; slot < trailOwners.size(); ++slot) {
+                if (trailSeen[slot] || !trailOwners[slot].Valid()) continue;
+                trails.Clear(planetCount + 1 + slot);
+                trailOwners[slot] = ObjectHandle();
+            }
+        }
+        trails.Submit(queue, static_cast<float>(world.simTime), cameraPos);
 
-    // Clean-up
-    for (auto& b : bodies) {
-        glDeleteVertexArrays(1, &b.VAO);
-        glDeleteBuffers(1, &b.VBO);
+        // Malla espacio-temporal (transparente, al final)
+        {
+            PROFILE_SCOPE("grid.Update");
+            grid.Update(state.objs, gridPool);
+        }
+        grid.Submit(queue, Frustum::FromMatrix(projection * view));
+
+        // Todo lo enviado, ordenado por estado y en tramos de una llamada
+        {
+            PROFILE_GPU_SCOPE("draw queue");
+            queue.Flush();
+        }
+
+        if (!headless) {
+            PROFILE_SCOPE("swap");
+            glfwSwapBuffers(window);
+        } else {
+            // La lectura sincroniza con la GPU; sin salida, glFinish para medir el frame completo
+            PROFILE_SCOPE("readback");
+            if (writer.IsOpen()) {
+                target.Read(pixels);
+                if (!writer.Write(pixels, width, height)) running = false;
+            } else {
+                glFinish();
+            }
+            if (++frameIndex >= headlessFrames) running = false;
+        }
+        profiler.EndFrame();
     }
-    for (auto& o : objs) {
-        glDeleteVertexArrays(1, &o.VAO);
-        glDeleteBuffers(1, &o.VBO);
+    simThread.Stop();
+    simThread.StopRecording();
+    if (!savePath.empty()) simThread.SaveSnapshot(savePath);
+    if (headless) {
+        writer.Close();
+        target.Destroy();
     }
-    glDeleteVertexArrays(1, &gridVAO);
-    glDeleteBuffers(1, &gridVBO);
+
+    // Percentiles de frame al salir y, si se pidió, el trace completo
+    profiler.PrintSummary();
+    if (!tracePath.empty()) profiler.ExportChromeTrace(tracePath);
+    if (!csvPath.empty()) profiler.ExportCsv(csvPath);
+    profiler.ReleaseGpu();
+
+
+    // Clean-up
+    spheres.Destroy();
+    trails.Destroy();
+    particles.Destroy();
+    queue.Destroy();
+    shader.Destroy();
+    camera.Destroy();
+    grid.Destroy();
     glfwTerminate();
     return 0;
 }
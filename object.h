@@ -1,33 +1,42 @@
 // object.h
 #pragma once
-#include <GL/glew.h>
 #include <glm/glm.hpp>
+#include <cstdint>
 #include <vector>
 
+// Referencia estable a un cuerpo de ObjectPool: índice de hueco + generación.
+// Sigue siendo válida aunque el cuerpo cambie de posición en el array denso; al
+// destruirlo la generación avanza y los handles viejos dejan de resolver.
+struct ObjectHandle {
+    static constexpr uint32_t NONE = 0xFFFFFFFFu;
+    uint32_t index = NONE;
+    uint32_t generation = 0;
+
+    bool Valid() const { return index != NONE; }
+    bool operator==(const ObjectHandle& o) const { return index == o.index && generation == o.generation; }
+    bool operator!=(const ObjectHandle& o) const { return !(*this == o); }
+};
+
+// Cuerpo simulado. No posee recursos GL: se dibuja como instancia de la esfera
+// unitaria compartida de SphereRenderer, escalada por su radio.
 class Object {
 public:
-    GLuint VAO = 0, VBO = 0;
     glm::vec3 position, velocity;
-    size_t vertexCount;
     glm::vec4 color = glm::vec4(1,0,0,1);
 
     bool Initalizing, Launched, target;
     float mass, density, radius;
     glm::vec3 LastPos;
+    ObjectHandle handle;  // lo asigna ObjectPool; inválido fuera de un pool
     glm::mat4 GetModelMatrix() const;
-    void Draw(GLuint shader) const;
 
     Object(glm::vec3 initPosition, glm::vec3 initVelocity, float mass, float density = 3344.0f);
 
-    void DrawRender() const;
-    void UpdatePos();
-    void UpdateVertices();
+    void UpdatePos(float dt);
     glm::vec3 GetPos() const;
-    void accelerate(float x, float y, float z);
-    float CheckCollision(const Object& other) const;
+    void accelerate(float x, float y, float z, float dt);
+    bool Overlaps(const Object& other) const;
+    void UpdateRadius();
 
     static glm::vec3 sphericalToCartesian(float r, float theta, float phi);
-
-private:
-    std::vector<float> Draw();
 };
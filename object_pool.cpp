@@ -0,0 +1,76 @@
+// object_pool.cpp
+#include "object_pool.h"
+
+ObjectHandle ObjectPool::Adopt(size_t denseIndex) {
+    uint32_t slot;
+    if (!freeSlots.empty()) {
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+    } else {
+        slot = static_cast<uint32_t>(slots.size());
+        slots.emplace_back();
+    }
+    slots[slot].dense = static_cast<uint32_t>(denseIndex);
+    ObjectHandle handle{slot, slots[slot].generation};
+    dense[denseIndex].handle = handle;
+    return handle;
+}
+
+// La generación avanza al liberar: los handles que apuntaban aquí dejan de valer
+void ObjectPool::Release(uint32_t slot) {
+    slots[slot].dense = FREE;
+    ++slots[slot].generation;
+    freeSlots.push_back(slot);
+}
+
+bool ObjectPool::Despawn(ObjectHandle handle) {
+    if (!Alive(handle)) return false;
+    const uint32_t index = slots[handle.index].dense;
+    const size_t last = dense.size() - 1;
+    if (index != last) {
+        dense[index] = std::move(dense[last]);
+        slots[dense[index].handle.index].dense = index;
+    }
+    dense.pop_back();
+    Release(handle.index);
+    return true;
+}
+
+Object* ObjectPool::Get(ObjectHandle handle) {
+    return const_cast<Object*>(static_cast<const ObjectPool*>(this)->Get(handle));
+}
+
+const Object* ObjectPool::Get(ObjectHandle handle) const {
+    if (handle.index >= slots.size()) return nullptr;
+    const Slot& slot = slots[handle.index];
+    if (slot.generation != handle.generation || slot.dense >= dense.size()) return nullptr;
+    return &dense[slot.dense];
+}
+
+void ObjectPool::Reserve(size_t count) {
+    dense.reserve(count);
+    slots.reserve(count);
+    freeSlots.reserve(count);
+}
+
+void ObjectPool::Clear() {
+    for (const Object& o : dense)
+        if (o.handle.index < slots.size() && slots[o.handle.index].dense != FREE) Release(o.handle.index);
+    dense.clear();
+}
+
+void ObjectPool::Sync() {
+    // Se marcan los huecos ocupados y cada cuerpo reclama el suyo; los que nadie
+    // reclama eran de cuerpos que ya no están
+    for (Slot& slot : slots)
+        if (slot.dense != FREE) slot.dense = PENDING;
+    for (size_t i = 0; i < dense.size(); ++i) {
+        const ObjectHandle h = dense[i].handle;
+        const bool owned = h.index < slots.size() && slots[h.index].dense == PENDING &&
+                           slots[h.index].generation == h.generation;
+        if (owned) slots[h.index].dense = static_cast<uint32_t>(i);
+        else Adopt(i);  // nuevo, copiado de fuera o duplicado
+    }
+    for (uint32_t s = 0; s < slots.size(); ++s)
+        if (slots[s].dense == PENDING) Release(s);
+}
@@ -0,0 +1,64 @@
+// object_pool.h
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "object.h"
+
+// Slot map de Object: los cuerpos viven contiguos en Dense() (lo que recorren la
+// física, las colisiones y los snapshots) y cada uno tiene un hueco fijo que
+// traduce su ObjectHandle a la posición actual. Spawn y Despawn son O(1): el
+// hueco sale de una lista libre y el borrado mueve el último cuerpo al hueco.
+// Los huecos y el array denso solo crecen (geométricamente o con Reserve), así
+// que una ráfaga de spawns no reserva memoria por cuerpo.
+class ObjectPool {
+public:
+    template <typename... Args>
+    ObjectHandle Spawn(Args&&... args) {
+        dense.emplace_back(std::forward<Args>(args)...);
+        return Adopt(dense.size() - 1);
+    }
+    bool Despawn(ObjectHandle handle);  // false si el handle ya no es válido
+
+    Object* Get(ObjectHandle handle);
+    const Object* Get(ObjectHandle handle) const;
+    bool Alive(ObjectHandle handle) const { return Get(handle) != nullptr; }
+
+    size_t Size() const { return dense.size(); }
+    bool Empty() const { return dense.empty(); }
+    size_t SlotCount() const { return slots.size(); }  // cota de handle.index
+    void Reserve(size_t count);
+    void Clear();
+
+    // Array denso, en el orden de iteración. Quien lo reordene, compacte o rellene
+    // directamente (fusiones de CollisionSystem, Restore de un snapshot) llama
+    // después a Sync(): los cuerpos sin handle reciben uno y los huecos de los
+    // que desaparecieron se liberan.
+    std::vector<Object>& Dense() { return dense; }
+    const std::vector<Object>& Dense() const { return dense; }
+    void Sync();
+
+    Object& operator[](size_t i) { return dense[i]; }
+    const Object& operator[](size_t i) const { return dense[i]; }
+    std::vector<Object>::iterator begin() { return dense.begin(); }
+    std::vector<Object>::iterator end() { return dense.end(); }
+    std::vector<Object>::const_iterator begin() const { return dense.begin(); }
+    std::vector<Object>::const_iterator end() const { return dense.end(); }
+
+private:
+    static constexpr uint32_t FREE = 0xFFFFFFFFu;     // hueco sin cuerpo
+    static constexpr uint32_t PENDING = 0xFFFFFFFEu;  // durante Sync()
+
+    struct Slot {
+        uint32_t generation = 1;
+        uint32_t dense = FREE;
+    };
+
+    std::vector<Object> dense;
+    std::vector<Slot> slots;
+    std::vector<uint32_t> freeSlots;
+
+    ObjectHandle Adopt(size_t denseIndex);
+    void Release(uint32_t slot);
+};
@@ -0,0 +1,160 @@
+// octree.cpp
+#include "octree.h"
+#include <algorithm>
+#include <cmath>
+
+int Octree::NewNode(float cx, float cy, float cz, float half) {
+    Node node;
+    node.cx = cx; node.cy = cy; node.cz = cz; node.half = half;
+    node.comX = node.comY = node.comZ = 0.0f;
+    node.mu = 0.0f;
+    std::fill(std::begin(node.child), std::end(node.child), -1);
+    node.firstBody = -1;
+    node.count = 0;
+    node.leaf = true;
+    nodes.push_back(node);
+    return static_cast<int>(nodes.size()) - 1;
+}
+
+int Octree::Octant(const Node& node, int body) const {
+    return (px[body] >= node.cx ? 1 : 0)
+         | (py[body] >= node.cy ? 2 : 0)
+         | (pz[body] >= node.cz ? 4 : 0);
+}
+
+void Octree::Build(const float* x, const float* y, const float* z, const float* m, size_t n) {
+    px = x; py = y; pz = z; mu = m;
+    nodes.clear();
+    next.assign(n, -1);
+    if (n == 0) return;
+    nodes.reserve(n / 2 + 1);
+
+    // Cubo que contiene todos los cuerpos
+    float minX = x[0], maxX = x[0], minY = y[0], maxY = y[0], minZ = z[0], maxZ = z[0];
+    for (size_t i = 1; i < n; ++i) {
+        minX = std::min(minX, x[i]); maxX = std::max(maxX, x[i]);
+        minY = std::min(minY, y[i]); maxY = std::max(maxY, y[i]);
+        minZ = std::min(minZ, z[i]); maxZ = std::max(maxZ, z[i]);
+    }
+    float half = 0.5f * std::max({maxX - minX, maxY - minY, maxZ - minZ}) * 1.0001f + 1e-3f;
+    NewNode(0.5f * (minX + maxX), 0.5f * (minY + maxY), 0.5f * (minZ + maxZ), half);
+
+    for (size_t i = 0; i < n; ++i) Insert(static_cast<int>(i));
+    ComputeMoments();
+}
+
+void Octree::Insert(int body) {
+    int node = 0;
+    int depth = 0;
+    while (true) {
+        if (nodes[node].leaf) {
+            if (nodes[node].count < LEAF_CAPACITY || depth >= MAX_DEPTH) {
+                next[body] = nodes[node].firstBody;
+                nodes[node].firstBody = body;
+                nodes[node].count++;
+                return;
+            }
+            // Hoja llena: se convierte en nodo interno y reparte sus cuerpos
+            int moving = nodes[node].firstBody;
+            nodes[node].firstBody = -1;
+            nodes[node].count = 0;
+            nodes[node].leaf = false;
+            while (moving != -1) {
+                int following = next[moving];
+                int oct = Octant(nodes[node], moving);
+                int childIdx = nodes[node].child[oct];
+                if (childIdx < 0) {
+                    float h = nodes[node].half * 0.5f;
+                    childIdx = NewNode(nodes[node].cx + ((oct & 1) ? h : -h),
+                                       nodes[node].cy + ((oct & 2) ? h : -h),
+                                       nodes[node].cz + ((oct & 4) ? h : -h), h);
+                    nodes[node].child[oct] = childIdx;
+                }
+                next[moving] = nodes[childIdx].firstBody;
+                nodes[childIdx].firstBody = moving;
+                nodes[childIdx].count++;
+                moving = following;
+            }
+        }
+
+        int oct = Octant(nodes[node], body);
+        int childIdx = nodes[node].child[oct];
+        if (childIdx < 0) {
+            float h = nodes[node].half * 0.5f;
+            childIdx = NewNode(nodes[node].cx + ((oct & 1) ? h : -h),
+                               nodes[node].cy + ((oct & 2) ? h : -h),
+                               nodes[node].cz + ((oct & 4) ? h : -h), h);
+            nodes[node].child[oct] = childIdx;
+        }
+        node = childIdx;
+        ++depth;
+    }
+}
+
+// Los hijos siempre se crean después que su padre, así que recorrer el array
+// al revés procesa cada nodo después de todos sus descendientes.
+void Octree::ComputeMoments() {
+    for (int idx = static_cast<int>(nodes.size()) - 1; idx >= 0; --idx) {
+        Node& node = nodes[idx];
+        float m = 0.0f, sx = 0.0f, sy = 0.0f, sz = 0.0f;
+        if (node.leaf) {
+            for (int b = node.firstBody; b != -1; b = next[b]) {
+                m += mu[b];
+                sx += mu[b] * px[b]; sy += mu[b] * py[b]; sz += mu[b] * pz[b];
+            }
+        } else {
+            for (int c : node.child) {
+                if (c < 0) continue;
+                const Node& ch = nodes[c];
+                m += ch.mu;
+                sx += ch.mu * ch.comX; sy += ch.mu * ch.comY; sz += ch.mu * ch.comZ;
+            }
+        }
+        node.mu = m;
+        if (m > 0.0f) {
+            node.comX = sx / m; node.comY = sy / m; node.comZ = sz / m;
+        } else {
+            node.comX = node.cx; node.comY = node.cy; node.comZ = node.cz;
+        }
+    }
+}
+
+// Criterio de apertura: tamaño / distancia < theta  ->  se usa el monopolo del nodo
+void Octree::Accel(float x, float y, float z, int self, float theta, float eps2,
+                   float& ax, float& ay, float& az) const {
+    ax = ay = az = 0.0f;
+    if (nodes.empty()) return;
+
+    const float theta2 = theta * theta;
+    int stack[8 * MAX_DEPTH + 8];
+    int top = 0;
+    stack[top++] = 0;
+
+    while (top > 0) {
+        const Node& node = nodes[stack[--top]];
+        if (node.leaf) {
+            for (int b = node.firstBody; b != -1; b = next[b]) {
+                if (b == self) continue;
+                float dx = px[b] - x, dy = py[b] - y, dz = pz[b] - z;
+                float r2 = dx * dx + dy * dy + dz * dz + eps2;
+                float invR = 1.0f / std::sqrt(r2);
+                float s = mu[b] * invR * invR * invR;
+                ax += dx * s; ay += dy * s; az += dz * s;
+            }
+            continue;
+        }
+
+        float dx = node.comX - x, dy = node.comY - y, dz = node.comZ - z;
+        float d2 = dx * dx + dy * dy + dz * dz;
+        float size = 2.0f * node.half;
+        if (size * size < theta2 * d2) {
+            float r2 = d2 + eps2;
+            float invR = 1.0f / std::sqrt(r2);
+            float s = node.mu * invR * invR * invR;
+            ax += dx * s; ay += dy * s; az += dz * s;
+        } else {
+            for (int c : node.child)
+                if (c >= 0) stack[top++] = c;
+        }
+    }
+}
@@ -0,0 +1,43 @@
+// octree.h
+#pragma once
+#include <cstddef>
+#include <vector>
+
+// Octree Barnes-Hut sobre arrays SoA. Se reconstruye en cada paso a partir de
+// las posiciones; cada nodo guarda su masa (como mu = G*m) y su centro de masa.
+class Octree {
+public:
+    static constexpr int LEAF_CAPACITY = 8;  // cuerpos por hoja antes de subdividir
+    static constexpr int MAX_DEPTH = 24;     // tope para cuerpos coincidentes
+
+    struct Node {
+        float cx, cy, cz, half;     // cubo del nodo
+        float comX, comY, comZ;     // centro de masa
+        float mu;                   // suma de G*m
+        int child[8];               // -1 si no existe
+        int firstBody;              // lista enlazada de cuerpos (solo hojas)
+        int count;
+        bool leaf;
+    };
+
+    void Build(const float* px, const float* py, const float* pz, const float* mu, size_t n);
+
+    // Aceleración sobre el cuerpo `self` (o un punto cualquiera si self < 0)
+    void Accel(float x, float y, float z, int self, float theta, float eps2,
+               float& ax, float& ay, float& az) const;
+
+    size_t NodeCount() const { return nodes.size(); }
+
+private:
+    std::vector<Node> nodes;
+    std::vector<int> next;  // siguiente cuerpo en la hoja
+    const float* px = nullptr;
+    const float* py = nullptr;
+    const float* pz = nullptr;
+    const float* mu = nullptr;
+
+    int NewNode(float cx, float cy, float cz, float half);
+    int Octant(const Node& node, int body) const;
+    void Insert(int body);
+    void ComputeMoments();
+};
@@ -0,0 +1,107 @@
+// offscreen.cpp
+#include "offscreen.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#endif
+
+bool OffscreenTarget::Init(int w, int h) {
+    width = w;
+    height = h;
+    glGenFramebuffers(1, &fbo);
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+
+    glGenRenderbuffers(1, &colorRBO);
+    glBindRenderbuffer(GL_RENDERBUFFER, colorRBO);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorRBO);
+
+    glGenRenderbuffers(1, &depthRBO);
+    glBindRenderbuffer(GL_RENDERBUFFER, depthRBO);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depthRBO);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    if (status != GL_FRAMEBUFFER_COMPLETE) {
+        std::cerr << "Offscreen framebuffer incomplete: 0x" << std::hex << status << std::dec << std::endl;
+        Destroy();
+        return false;
+    }
+    glViewport(0, 0, width, height);
+    return true;
+}
+
+void OffscreenTarget::Destroy() {
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glDeleteFramebuffers(1, &fbo);
+    glDeleteRenderbuffers(1, &colorRBO);
+    glDeleteRenderbuffers(1, &depthRBO);
+    fbo = colorRBO = depthRBO = 0;
+}
+
+void OffscreenTarget::Bind() const {
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glViewport(0, 0, width, height);
+}
+
+void OffscreenTarget::Read(std::vector<unsigned char>& rgb) const {
+    const size_t stride = static_cast<size_t>(width) * 3;
+    rows.resize(stride * height);
+    rgb.resize(rows.size());
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, width, height, GL_RGB, GL_UNSIGNED_BYTE, rows.data());
+    // GL entrega la primera fila abajo; las imágenes la esperan arriba
+    for (int y = 0; y < height; ++y)
+        std::memcpy(&rgb[y * stride], &rows[(height - 1 - y) * stride], stride);
+}
+
+bool FrameWriter::Open(const std::string& target) {
+    frame = 0;
+    if (target == "-") {
+#ifdef _WIN32
+        _setmode(_fileno(stdout), _O_BINARY);
+#endif
+        toStdout = true;
+        return true;
+    }
+    if (target.find('%') == std::string::npos) {
+        std::cerr << "Frame output needs a printf pattern like frames/frame_%05d.ppm, or - for stdout" << std::endl;
+        return false;
+    }
+    pattern = target;
+    std::error_code ec;
+    std::filesystem::path dir = std::filesystem::path(pattern).parent_path();
+    if (!dir.empty()) std::filesystem::create_directories(dir, ec);
+    return true;
+}
+
+bool FrameWriter::Write(const std::vector<unsigned char>& rgb, int width, int height) {
+    if (toStdout) {
+        bool ok = std::fwrite(rgb.data(), 1, rgb.size(), stdout) == rgb.size();
+        ++frame;
+        return ok;
+    }
+    char name[1024];
+    std::snprintf(name, sizeof(name), pattern.c_str(), frame++);
+    FILE* f = std::fopen(name, "wb");
+    if (!f) {
+        std::cerr << "Could not write frame " << name << std::endl;
+        return false;
+    }
+    std::fprintf(f, "P6\n%d %d\n255\n", width, height);
+    bool ok = std::fwrite(rgb.data(), 1, rgb.size(), f) == rgb.size();
+    std::fclose(f);
+    return ok;
+}
+
+void FrameWriter::Close() {
+    if (toStdout) std::fflush(stdout);
+    toStdout = false;
+    pattern.clear();
+}
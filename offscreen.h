@@ -0,0 +1,43 @@
+// offscreen.h
+#pragma once
+#include <GL/glew.h>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Framebuffer propio (color + profundidad) para renderizar sin ventana visible
+// a la resolución pedida, independiente del tamaño de la superficie del contexto.
+class OffscreenTarget {
+public:
+    bool Init(int width, int height);
+    void Destroy();
+
+    void Bind() const;
+    // RGB de 8 bits, filas de arriba a abajo (listo para PPM o rawvideo)
+    void Read(std::vector<unsigned char>& rgb) const;
+
+    int Width() const { return width; }
+    int Height() const { return height; }
+
+private:
+    GLuint fbo = 0, colorRBO = 0, depthRBO = 0;
+    int width = 0, height = 0;
+    mutable std::vector<unsigned char> rows;  // lectura de GL, de abajo a arriba
+};
+
+// Salida de frames: con "-" escribe rgb24 crudo a stdout (para ffmpeg -f rawvideo);
+// si no, un PPM por frame con el patrón printf dado, p. ej. "frames/frame_%05d.ppm".
+class FrameWriter {
+public:
+    bool Open(const std::string& target);
+    bool Write(const std::vector<unsigned char>& rgb, int width, int height);
+    void Close();
+
+    bool IsOpen() const { return toStdout || !pattern.empty(); }
+    bool ToStdout() const { return toStdout; }
+
+private:
+    std::string pattern;
+    bool toStdout = false;
+    int frame = 0;
+};
@@ -0,0 +1,95 @@
+// particle_renderer.cpp
+#include "particle_renderer.h"
+
+static const char* particleVertexSrc = R"glsl(
+#version 330 core
+layout(location=0) in float aX;
+layout(location=1) in float aY;
+layout(location=2) in float aZ;
+layout(location=3) in vec4 aColor;
+)glsl" CAMERA_BLOCK_GLSL R"glsl(
+uniform float pixelScale;  // proyección[1][1] * alto / 2
+out vec4 vColor;
+void main(){
+    vec4 viewPos = view * vec4(aX, aY, aZ, 1.0);
+    // ~30 unidades de diámetro, nunca menos de un píxel
+    gl_PointSize = clamp(30.0 * pixelScale / max(-viewPos.z, 1.0), 1.0, 4.0);
+    vColor = aColor;
+    gl_Position = projection * viewPos;
+}
+)glsl";
+
+static const char* particleFragmentSrc = R"glsl(
+#version 330 core
+in vec4 vColor;
+out vec4 FragColor;
+void main(){
+    vec2 d = gl_PointCoord * 2.0 - 1.0;
+    if (dot(d, d) > 1.0) discard;
+    FragColor = vColor;
+}
+)glsl";
+
+bool ParticleRenderer::Init() {
+    if (!program.Build(particleVertexSrc, particleFragmentSrc, "particles")) return false;
+    glGenVertexArrays(1, &VAO);
+    glGenBuffers(1, &positionVBO);
+    glGenBuffers(1, &colorVBO);
+    glEnable(GL_PROGRAM_POINT_SIZE);
+    return true;
+}
+
+void ParticleRenderer::Destroy() {
+    glDeleteVertexArrays(1, &VAO);
+    glDeleteBuffers(1, &positionVBO);
+    glDeleteBuffers(1, &colorVBO);
+    program.Destroy();
+    count = 0;
+}
+
+void ParticleRenderer::SetColors(const std::vector<uint32_t>& colors) {
+    count = colors.size();
+    glBindVertexArray(VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, colorVBO);
+    glBufferData(GL_ARRAY_BUFFER, count * sizeof(uint32_t), colors.data(), GL_STATIC_DRAW);
+    glVertexAttribPointer(3, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(uint32_t), (void*)0);
+    glEnableVertexAttribArray(3);
+
+    glBindBuffer(GL_ARRAY_BUFFER, positionVBO);
+    glBufferData(GL_ARRAY_BUFFER, count * 3 * sizeof(float), nullptr, GL_STREAM_DRAW);
+    for (GLuint axis = 0; axis < 3; ++axis) {
+        glVertexAttribPointer(axis, 1, GL_FLOAT, GL_FALSE, sizeof(float), (void*)(axis * count * sizeof(float)));
+        glEnableVertexAttribArray(axis);
+    }
+    glBindVertexArray(0);
+}
+
+bool ParticleRenderer::Map(float*& x, float*& y, float*& z) {
+    if (count == 0) return false;
+    glBindBuffer(GL_ARRAY_BUFFER, positionVBO);
+    void* data = glMapBufferRange(GL_ARRAY_BUFFER, 0, count * 3 * sizeof(float),
+                                  GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+    if (!data) return false;
+    x = static_cast<float*>(data);
+    y = x + count;
+    z = y + count;
+    return true;
+}
+
+void ParticleRenderer::Unmap() {
+    glBindBuffer(GL_ARRAY_BUFFER, positionVBO);
+    glUnmapBuffer(GL_ARRAY_BUFFER);
+}
+
+void ParticleRenderer::Submit(RenderQueue& queue, float pixelScale, float depth) {
+    if (count == 0) return;
+    material.program = &program;
+    material.apply = [this, pixelScale] { glUniform1f(program.Uniform("pixelScale"), pixelScale); };
+    DrawPacket packet;
+    packet.material = &material;
+    packet.vao = VAO;
+    packet.mode = GL_POINTS;
+    packet.count = static_cast<GLuint>(count);
+    packet.depth = depth;
+    queue.Submit(packet);
+}
@@ -0,0 +1,37 @@
+// particle_renderer.h
+#pragma once
+#include <GL/glew.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "render_queue.h"
+#include "shader.h"
+
+// Partículas (cinturón, anillos) como puntos redondos: 12 bytes de posición por
+// partícula y frame, en SoA (x[], y[], z[] seguidos en un buffer) tal como los
+// escribe ParticleBelt::Evaluate, más un color RGBA8 fijo en otro buffer.
+// Un solo paquete GL_POINTS.
+class ParticleRenderer {
+public:
+    bool Init();  // false si el programa no compila o no enlaza
+    void Destroy();
+
+    // Fija el número de partículas y sus colores (realoca los buffers)
+    void SetColors(const std::vector<uint32_t>& colors);
+    size_t Count() const { return count; }
+
+    // Mapea el buffer de posiciones invalidando el anterior (sin esperar a la GPU);
+    // los tres arrays se pueden escribir desde cualquier hilo hasta Unmap()
+    bool Map(float*& x, float*& y, float*& z);
+    void Unmap();
+
+    // pixelScale = proyección[1][1] * alto / 2, para el tamaño de los puntos;
+    // depth, distancia de la cámara al sistema (view/projection: UBO de cámara)
+    void Submit(RenderQueue& queue, float pixelScale, float depth);
+
+private:
+    ShaderProgram program;
+    RenderMaterial material;
+    GLuint VAO = 0, positionVBO = 0, colorVBO = 0;
+    size_t count = 0;
+};
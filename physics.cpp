@@ -0,0 +1,549 @@
+// physics.cpp
+#include "globals.h"
+#include "physics.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <random>
+
+// Cuerpos por tarea del pool: las fuerzas cuestan O(n) por cuerpo, la integración O(1)
+static constexpr size_t FORCE_GRAIN = 64;
+static constexpr size_t INTEGRATE_GRAIN = 8192;
+
+void BodySoA::Resize(size_t n) {
+    px.resize(n); py.resize(n); pz.resize(n);
+    vx.resize(n); vy.resize(n); vz.resize(n);
+    ax.resize(n, 0.0f); ay.resize(n, 0.0f); az.resize(n, 0.0f);
+    mass.resize(n); mu.resize(n);
+    pinned.resize(n, 0);
+}
+
+Simulation::Simulation(const SimConfig& cfg)
+    : config(cfg),
+      simd(DetectSimdLevel()),
+      pool(cfg.threads)
+{
+    // a = G*m/r^2 con r en unidades y t en segundos de escena:
+    // G' = G * timeScale^2 / metersPerUnit^3
+    gravityScale = G * config.timeScale * config.timeScale
+                 / (config.metersPerUnit * config.metersPerUnit * config.metersPerUnit);
+}
+
+// Copia el estado de los Object al SoA. Si cambia el número de cuerpos, una masa
+// o una posición (fusiones, cargar un snapshot), las aceleraciones guardadas ya no
+// valen y se recalculan antes del siguiente paso. Si algo difiere de lo que dejó
+// WriteBack, el estado en doble de Hermite se resiembra.
+void Simulation::Sync(const std::vector<Object>& objs) {
+    size_t n = objs.size();
+    if (n != bodies.Size()) {
+        bodies.Resize(n);
+        accelDirty = true;
+    }
+    for (size_t i = 0; i < n; ++i) {
+        const Object& o = objs[i];
+        const unsigned char pinned = o.Initalizing ? 1 : 0;
+        if (bodies.px[i] != o.position.x || bodies.py[i] != o.position.y || bodies.pz[i] != o.position.z) {
+            accelDirty = true;
+            hermiteDirty = true;
+        }
+        if (bodies.vx[i] != o.velocity.x || bodies.vy[i] != o.velocity.y || bodies.vz[i] != o.velocity.z ||
+            bodies.pinned[i] != pinned)
+            hermiteDirty = true;
+        bodies.px[i] = o.position.x; bodies.py[i] = o.position.y; bodies.pz[i] = o.position.z;
+        bodies.vx[i] = o.velocity.x; bodies.vy[i] = o.velocity.y; bodies.vz[i] = o.velocity.z;
+        if (bodies.mass[i] != o.mass) accelDirty = true;
+        bodies.mass[i] = o.mass;
+        bodies.mu[i] = static_cast<float>(gravityScale * o.mass);
+        bodies.pinned[i] = pinned;
+    }
+    stats.bodies = n;
+}
+
+void Simulation::WriteBack(std::vector<Object>& objs) const {
+    size_t n = std::min(objs.size(), bodies.Size());
+    for (size_t i = 0; i < n; ++i) {
+        objs[i].LastPos = objs[i].position;
+        objs[i].position = glm::vec3(bodies.px[i], bodies.py[i], bodies.pz[i]);
+        objs[i].velocity = glm::vec3(bodies.vx[i], bodies.vy[i], bodies.vz[i]);
+    }
+}
+
+const char* IntegratorName(Integrator integrator) {
+    switch (integrator) {
+        case Integrator::Yoshida4: return "Yoshida4";
+        case Integrator::Hermite4: return "Hermite4";
+        default: return "Leapfrog";
+    }
+}
+
+void Simulation::Step() {
+    auto t0 = std::chrono::steady_clock::now();
+
+    const float dt = config.fixedDt;
+    const size_t n = bodies.Size();
+    stats.substeps = 1;
+    if (config.integrator == Integrator::Hermite4) {
+        StepHermite();
+    } else if (config.integrator == Integrator::Yoshida4) {
+        // w1 + w0 + w1 = 1; w0 < 0: el subpaso central va hacia atrás
+        const double cbrt2 = std::cbrt(2.0);
+        const double w1 = 1.0 / (2.0 - cbrt2), w0 = -cbrt2 / (2.0 - cbrt2);
+        Leapfrog(static_cast<float>(w1 * dt));
+        Leapfrog(static_cast<float>(w0 * dt));
+        Leapfrog(static_cast<float>(w1 * dt));
+        stats.substeps = 3;
+        stats.bodyUpdates = static_cast<long long>(3 * n);
+    } else {
+        Leapfrog(dt);
+        stats.bodyUpdates = static_cast<long long>(n);
+    }
+
+    auto t1 = std::chrono::steady_clock::now();
+    stats.lastStepMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
+    double instant = stats.lastStepMs > 0.0 ? 1000.0 / stats.lastStepMs : 0.0;
+    // Media exponencial para que la cifra no salte frame a frame
+    stats.stepsPerSecond = stats.totalSteps == 0 ? instant : 0.9 * stats.stepsPerSecond + 0.1 * instant;
+    ++stats.totalSteps;
+}
+
+// Un paso velocity-Verlet: v += a*dt/2; x += v*dt; a = F(x); v += a*dt/2
+void Simulation::Leapfrog(float dt) {
+    if (accelDirty) {
+        ComputeAccelerations();
+        accelDirty = false;
+    }
+
+    const float half = 0.5f * dt;
+    const size_t n = bodies.Size();
+
+    pool.ParallelFor(n, INTEGRATE_GRAIN, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            if (bodies.pinned[i]) continue;
+            bodies.vx[i] += bodies.ax[i] * half;
+            bodies.vy[i] += bodies.ay[i] * half;
+            bodies.vz[i] += bodies.az[i] * half;
+            bodies.px[i] += bodies.vx[i] * dt;
+            bodies.py[i] += bodies.vy[i] * dt;
+            bodies.pz[i] += bodies.vz[i] * dt;
+        }
+    });
+
+    ComputeAccelerations();
+
+    pool.ParallelFor(n, INTEGRATE_GRAIN, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            if (bodies.pinned[i]) continue;
+            bodies.vx[i] += bodies.ax[i] * half;
+            bodies.vy[i] += bodies.ay[i] * half;
+            bodies.vz[i] += bodies.az[i] * half;
+        }
+    });
+}
+
+void Simulation::HermiteState::Resize(size_t n) {
+    for (auto* v : {&x, &y, &z, &vx, &vy, &vz, &ax, &ay, &az, &jx, &jy, &jz, &px, &py, &pz, &pvx, &pvy, &pvz})
+        v->resize(n);
+    time.resize(n);
+    step.resize(n);
+}
+
+// Mayor potencia de dos (en pasos mínimos) que no supera el ideal. Reducir siempre
+// es posible; doblar solo si el tiempo actual es múltiplo del paso doble, para que
+// los bloques sigan alineados
+static uint32_t QuantizeStep(double ideal, uint32_t current, uint32_t time, uint32_t maxStep) {
+    uint32_t s = current;
+    if (ideal < s) {
+        while (s > 1 && s > ideal) s >>= 1;
+    } else if (ideal >= 2.0 * s && 2 * s <= maxStep && time % (2 * s) == 0) {
+        s *= 2;
+    }
+    return s;
+}
+
+void Simulation::HermiteForces() {
+    HermiteState& h = hermite;
+    const size_t n = bodies.Size();
+    const size_t count = h.active.size();
+    const double eps2 = static_cast<double>(config.softening) * config.softening;
+    for (auto* v : {&h.nax, &h.nay, &h.naz, &h.njx, &h.njy, &h.njz}) v->resize(count);
+    pool.ParallelFor(count, FORCE_GRAIN, [&](size_t begin, size_t end) {
+        for (size_t k = begin; k < end; ++k) {
+            const size_t i = h.active[k];
+            double ax = 0.0, ay = 0.0, az = 0.0, jx = 0.0, jy = 0.0, jz = 0.0;
+            for (size_t j = 0; j < n; ++j) {
+                if (j == i) continue;
+                const double dx = h.px[j] - h.px[i], dy = h.py[j] - h.py[i], dz = h.pz[j] - h.pz[i];
+                const double dvx = h.pvx[j] - h.pvx[i], dvy = h.pvy[j] - h.pvy[i], dvz = h.pvz[j] - h.pvz[i];
+                const double r2 = dx * dx + dy * dy + dz * dz + eps2;
+                const double inv2 = 1.0 / r2;
+                const double mr3 = bodies.mu[j] * inv2 * std::sqrt(inv2);
+                const double rv = 3.0 * (dx * dvx + dy * dvy + dz * dvz) * inv2;
+                ax += mr3 * dx; ay += mr3 * dy; az += mr3 * dz;
+                jx += mr3 * (dvx - rv * dx); jy += mr3 * (dvy - rv * dy); jz += mr3 * (dvz - rv * dz);
+            }
+            h.nax[k] = ax; h.nay[k] = ay; h.naz[k] = az;
+            h.njx[k] = jx; h.njy[k] = jy; h.njz[k] = jz;
+        }
+    });
+}
+
+// Hermite de 4º orden con pasos por bloques (Makino y Aarseth). Dentro del paso
+// fijo se salta de subpaso en subpaso: el siguiente es el menor t_i + dt_i, se
+// predicen todos los cuerpos a ese instante y solo los que llegan a él (los
+// activos) se evalúan y se corrigen. Al final del paso todos están sincronizados.
+void Simulation::StepHermite() {
+    HermiteState& h = hermite;
+    const size_t n = bodies.Size();
+    const uint32_t level = static_cast<uint32_t>(std::clamp(config.maxBlockLevel, 0, 30));
+    const uint32_t END = 1u << level;
+    const double unit = static_cast<double>(config.fixedDt) / END;
+    const double eta = config.eta;
+
+    // El estado en doble sigue del paso anterior; solo se resiembra del SoA en
+    // float si los cuerpos cambiaron por fuera (o al cambiar de integrador)
+    const bool reseed = accelDirty || hermiteDirty || h.x.size() != n;
+    if (reseed) {
+        h.Resize(n);
+        for (size_t i = 0; i < n; ++i) {
+            h.x[i] = bodies.px[i]; h.y[i] = bodies.py[i]; h.z[i] = bodies.pz[i];
+            h.vx[i] = bodies.vx[i]; h.vy[i] = bodies.vy[i]; h.vz[i] = bodies.vz[i];
+        }
+        hermiteDirty = false;
+    }
+    std::fill(h.time.begin(), h.time.end(), 0u);
+
+    // Arranque (o cuerpos nuevos): a y jerk de todos, paso inicial eta_s * |a| / |j|
+    if (reseed) {
+        h.px = h.x; h.py = h.y; h.pz = h.z;
+        h.pvx = h.vx; h.pvy = h.vy; h.pvz = h.vz;
+        h.active.resize(n);
+        for (size_t i = 0; i < n; ++i) h.active[i] = static_cast<uint32_t>(i);
+        HermiteForces();
+        uint32_t shared = END;
+        for (size_t i = 0; i < n; ++i) {
+            h.ax[i] = h.nax[i]; h.ay[i] = h.nay[i]; h.az[i] = h.naz[i];
+            h.jx[i] = h.njx[i]; h.jy[i] = h.njy[i]; h.jz[i] = h.njz[i];
+            const double a = std::sqrt(h.ax[i] * h.ax[i] + h.ay[i] * h.ay[i] + h.az[i] * h.az[i]);
+            const double j = std::sqrt(h.jx[i] * h.jx[i] + h.jy[i] * h.jy[i] + h.jz[i] * h.jz[i]);
+            const double ideal = j > 0.0 ? 0.5 * eta * a / j / unit : END;
+            h.step[i] = QuantizeStep(ideal, END, 0, END);
+            if (!bodies.pinned[i]) shared = std::min(shared, h.step[i]);
+        }
+        if (!config.blockTimesteps) std::fill(h.step.begin(), h.step.end(), shared);
+        accelDirty = false;
+    }
+
+    stats.substeps = 0;
+    stats.bodyUpdates = 0;
+    for (;;) {
+        uint32_t next = UINT32_MAX;
+        for (size_t i = 0; i < n; ++i)
+            if (!bodies.pinned[i]) next = std::min(next, h.time[i] + h.step[i]);
+        if (next > END) break;
+
+        h.active.clear();
+        for (size_t i = 0; i < n; ++i)
+            if (!bodies.pinned[i] && h.time[i] + h.step[i] == next) h.active.push_back(static_cast<uint32_t>(i));
+
+        // Predicción de Taylor de todos al instante `next` (los fijos no se mueven)
+        pool.ParallelFor(n, INTEGRATE_GRAIN, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                const double dt = bodies.pinned[i] ? 0.0 : (next - h.time[i]) * unit;
+                const double dt2 = dt * dt * 0.5, dt3 = dt * dt * dt / 6.0;
+                h.px[i] = h.x[i] + h.vx[i] * dt + h.ax[i] * dt2 + h.jx[i] * dt3;
+                h.py[i] = h.y[i] + h.vy[i] * dt + h.ay[i] * dt2 + h.jy[i] * dt3;
+                h.pz[i] = h.z[i] + h.vz[i] * dt + h.az[i] * dt2 + h.jz[i] * dt3;
+                h.pvx[i] = h.vx[i] + h.ax[i] * dt + h.jx[i] * dt2;
+                h.pvy[i] = h.vy[i] + h.ay[i] * dt + h.jy[i] * dt2;
+                h.pvz[i] = h.vz[i] + h.az[i] * dt + h.jz[i] * dt2;
+            }
+        });
+
+        HermiteForces();
+
+        // Corrector con las derivadas 2ª y 3ª de a interpoladas y nuevo paso (Aarseth)
+        pool.ParallelFor(h.active.size(), INTEGRATE_GRAIN, [&](size_t begin, size_t end) {
+            for (size_t k = begin; k < end; ++k) {
+                const size_t i = h.active[k];
+                const double dt = (next - h.time[i]) * unit;
+                const double dt2 = dt * dt, dt3 = dt2 * dt;
+                double a2[3], a3[3], x[3], v[3];
+                const double a0[3] = {h.ax[i], h.ay[i], h.az[i]}, j0[3] = {h.jx[i], h.jy[i], h.jz[i]};
+                const double a1[3] = {h.nax[k], h.nay[k], h.naz[k]}, j1[3] = {h.njx[k], h.njy[k], h.njz[k]};
+                const double xp[3] = {h.px[i], h.py[i], h.pz[i]}, vp[3] = {h.pvx[i], h.pvy[i], h.pvz[i]};
+                double na1 = 0.0, nj1 = 0.0, na2 = 0.0, na3 = 0.0;
+                for (int c = 0; c < 3; ++c) {
+                    a2[c] = (-6.0 * (a0[c] - a1[c]) - dt * (4.0 * j0[c] + 2.0 * j1[c])) / dt2;
+                    a3[c] = (12.0 * (a0[c] - a1[c]) + 6.0 * dt * (j0[c] + j1[c])) / dt3;
+                    x[c] = xp[c] + a2[c] * dt2 * dt2 / 24.0 + a3[c] * dt3 * dt2 / 120.0;
+                    v[c] = vp[c] + a2[c] * dt3 / 6.0 + a3[c] * dt2 * dt2 / 24.0;
+                    const double a2end = a2[c] + a3[c] * dt;  // a2 en el nuevo instante
+                    na1 += a1[c] * a1[c]; nj1 += j1[c] * j1[c];
+                    na2 += a2end * a2end; na3 += a3[c] * a3[c];
+                }
+                h.x[i] = x[0]; h.y[i] = x[1]; h.z[i] = x[2];
+                h.vx[i] = v[0]; h.vy[i] = v[1]; h.vz[i] = v[2];
+                h.ax[i] = a1[0]; h.ay[i] = a1[1]; h.az[i] = a1[2];
+                h.jx[i] = j1[0]; h.jy[i] = j1[1]; h.jz[i] = j1[2];
+                h.time[i] = next;
+
+                na1 = std::sqrt(na1); nj1 = std::sqrt(nj1); na2 = std::sqrt(na2); na3 = std::sqrt(na3);
+                const double den = nj1 * na3 + na2 * na2;
+                const double ideal = den > 0.0 ? std::sqrt(eta * (na1 * na2 + nj1 * nj1) / den) / unit : END;
+                h.step[i] = QuantizeStep(ideal, h.step[i], next, END);
+            }
+        });
+        // Paso compartido: todos son activos siempre y se quedan con el más corto
+        if (!config.blockTimesteps) {
+            uint32_t shared = END;
+            for (uint32_t i : h.active) shared = std::min(shared, h.step[i]);
+            for (uint32_t i : h.active) h.step[i] = shared;
+        }
+
+        ++stats.substeps;
+        stats.bodyUpdates += static_cast<long long>(h.active.size());
+    }
+
+    for (size_t i = 0; i < n; ++i) {
+        if (bodies.pinned[i]) continue;
+        bodies.px[i] = static_cast<float>(h.x[i]); bodies.py[i] = static_cast<float>(h.y[i]); bodies.pz[i] = static_cast<float>(h.z[i]);
+        bodies.vx[i] = static_cast<float>(h.vx[i]); bodies.vy[i] = static_cast<float>(h.vy[i]); bodies.vz[i] = static_cast<float>(h.vz[i]);
+        bodies.ax[i] = static_cast<float>(h.ax[i]); bodies.ay[i] = static_cast<float>(h.ay[i]); bodies.az[i] = static_cast<float>(h.az[i]);
+    }
+}
+
+double Simulation::Energy() const {
+    const size_t n = bodies.Size();
+    const double eps2 = static_cast<double>(config.softening) * config.softening;
+    double kinetic = 0.0, potential = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        const double v2 = static_cast<double>(bodies.vx[i]) * bodies.vx[i] +
+                          static_cast<double>(bodies.vy[i]) * bodies.vy[i] +
+                          static_cast<double>(bodies.vz[i]) * bodies.vz[i];
+        kinetic += 0.5 * bodies.mass[i] * v2;
+        for (size_t j = i + 1; j < n; ++j) {
+            const double dx = static_cast<double>(bodies.px[j]) - bodies.px[i];
+            const double dy = static_cast<double>(bodies.py[j]) - bodies.py[i];
+            const double dz = static_cast<double>(bodies.pz[j]) - bodies.pz[i];
+            potential -= static_cast<double>(bodies.mass[i]) * bodies.mu[j] / std::sqrt(dx * dx + dy * dy + dz * dz + eps2);
+        }
+    }
+    return kinetic + potential;
+}
+
+void Simulation::ComputeAccelerations() {
+    if (config.forceMode == ForceMode::BarnesHut)
+        ComputeAccelerationsBarnesHut();
+    else
+        ComputeAccelerationsDirect();
+}
+
+// Suma directa sobre el SoA con el kernel SIMD detectado (o el escalar)
+void Simulation::ComputeAccelerationsDirect() {
+    const size_t n = bodies.Size();
+    const float eps2 = config.softening * config.softening;
+    pool.ParallelFor(n, FORCE_GRAIN, [&](size_t begin, size_t end) {
+        DirectAccel(simd, bodies.px.data(), bodies.py.data(), bodies.pz.data(), bodies.mu.data(), n,
+                    eps2, bodies.ax.data(), bodies.ay.data(), bodies.az.data(), begin, end);
+    });
+}
+
+// El árbol se reconstruye en cada evaluación: las posiciones cambian en cada paso
+void Simulation::ComputeAccelerationsBarnesHut() {
+    const size_t n = bodies.Size();
+    const float eps2 = config.softening * config.softening;
+
+    tree.Build(bodies.px.data(), bodies.py.data(), bodies.pz.data(), bodies.mu.data(), n);
+    pool.ParallelFor(n, FORCE_GRAIN, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            tree.Accel(bodies.px[i], bodies.py[i], bodies.pz[i], static_cast<int>(i),
+                       config.theta, eps2, bodies.ax[i], bodies.ay[i], bodies.az[i]);
+        }
+    });
+}
+
+// Nube esférica aleatoria con masas parecidas, determinista por semilla.
+// Se escribe directamente en el SoA: no hay contexto GL para crear Objects.
+static void FillRandomCluster(Simulation& sim, size_t n, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> uni(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> massDist(1e20f, 1e22f);
+    BodySoA& b = sim.Bodies();
+    b.Resize(n);
+    size_t i = 0;
+    while (i < n) {
+        float x = uni(rng), y = uni(rng), z = uni(rng);
+        if (x * x + y * y + z * z > 1.0f) continue;
+        b.px[i] = x * 20000.0f; b.py[i] = y * 20000.0f; b.pz[i] = z * 20000.0f;
+        b.vx[i] = b.vy[i] = b.vz[i] = 0.0f;
+        b.mass[i] = massDist(rng);
+        b.mu[i] = static_cast<float>(sim.GravityScale() * b.mass[i]);
+        ++i;
+    }
+}
+
+// Para n grande la referencia directa completa es inasumible: el error se mide
+// sobre una muestra de cuerpos y el coste directo por paso se extrapola.
+void PrintForceAccuracyReport() {
+    const size_t sizes[] = {1000, 10000, 100000};
+    const float thetas[] = {0.3f, 0.5f, 0.7f, 1.0f};
+    const size_t SAMPLE = 1000;
+
+    std::cout << "n\ttheta\terr_p50\terr_p99\tbh_ms\tdirect_ms(est)" << std::endl;
+    for (size_t n : sizes) {
+        Simulation sim;
+        FillRandomCluster(sim, n, 1234u);
+        const BodySoA& b = sim.Bodies();
+        const float eps2 = sim.Config().softening * sim.Config().softening;
+
+        // Referencia exacta en doble precisión para los cuerpos muestreados
+        size_t sample = std::min(SAMPLE, n);
+        size_t stride = n / sample;
+        std::vector<double> refX(sample), refY(sample), refZ(sample);
+        for (size_t s = 0; s < sample; ++s) {
+            size_t i = s * stride;
+            double ax = 0.0, ay = 0.0, az = 0.0;
+            for (size_t j = 0; j < n; ++j) {
+                if (j == i) continue;
+                double dx = b.px[j] - b.px[i], dy = b.py[j] - b.py[i], dz = b.pz[j] - b.pz[i];
+                double r2 = dx * dx + dy * dy + dz * dz + eps2;
+                double s3 = b.mu[j] / (r2 * std::sqrt(r2));
+                ax += dx * s3; ay += dy * s3; az += dz * s3;
+            }
+            refX[s] = ax; refY[s] = ay; refZ[s] = az;
+        }
+
+        // Coste de la suma directa del motor, extrapolado desde los primeros `sample` cuerpos
+        BodySoA& w = sim.Bodies();
+        auto t0 = std::chrono::steady_clock::now();
+        DirectAccel(sim.GetSimdLevel(), w.px.data(), w.py.data(), w.pz.data(), w.mu.data(), n,
+                    eps2, w.ax.data(), w.ay.data(), w.az.data(), 0, sample);
+        auto t1 = std::chrono::steady_clock::now();
+        double directMs = std::chrono::duration<double, std::milli>(t1 - t0).count() * n / sample;
+
+        for (float theta : thetas) {
+            sim.SetForceMode(ForceMode::BarnesHut);
+            sim.SetTheta(theta);
+            auto b0 = std::chrono::steady_clock::now();
+            sim.ComputeAccelerations();
+            auto b1 = std::chrono::steady_clock::now();
+            double bhMs = std::chrono::duration<double, std::milli>(b1 - b0).count();
+
+            std::vector<double> err(sample);
+            for (size_t s = 0; s < sample; ++s) {
+                size_t i = s * stride;
+                double ex = b.ax[i] - refX[s], ey = b.ay[i] - refY[s], ez = b.az[i] - refZ[s];
+                double ref = std::sqrt(refX[s] * refX[s] + refY[s] * refY[s] + refZ[s] * refZ[s]);
+                err[s] = std::sqrt(ex * ex + ey * ey + ez * ez) / std::max(ref, 1e-30);
+            }
+            std::sort(err.begin(), err.end());
+            std::cout << n << "\t" << theta << "\t"
+                      << err[sample / 2] << "\t" << err[(sample * 99) / 100] << "\t"
+                      << bhMs << "\t" << directMs << std::endl;
+        }
+    }
+}
+
+// Estrella central, un planeta gigante con un satélite muy cerrado (periodo de
+// unos pocos pasos fijos) y una nube de cuerpos ligeros en órbitas circulares
+// amplias: los pasos que necesita cada uno varían en dos o tres órdenes de magnitud
+static void FillHierarchicalSystem(Simulation& sim, size_t lightBodies, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> uni(0.0, 1.0);
+    BodySoA& b = sim.Bodies();
+    b.Resize(3 + lightBodies);
+    const double scale = sim.GravityScale();
+    auto place = [&](size_t i, double mass, double x, double z, double vx, double vz) {
+        b.px[i] = static_cast<float>(x); b.py[i] = 0.0f; b.pz[i] = static_cast<float>(z);
+        b.vx[i] = static_cast<float>(vx); b.vy[i] = 0.0f; b.vz[i] = static_cast<float>(vz);
+        b.mass[i] = static_cast<float>(mass);
+        b.mu[i] = static_cast<float>(scale * mass);
+    };
+    const double starMass = 2e30, giantMass = 2e27, moonMass = 1e23;
+    const double muStar = scale * starMass, muGiant = scale * giantMass;
+    const double giantR = 10000.0, moonR = 150.0;
+    place(0, starMass, 0.0, 0.0, 0.0, 0.0);
+    const double vGiant = std::sqrt(muStar / giantR), vMoon = std::sqrt(muGiant / moonR);
+    place(1, giantMass, giantR, 0.0, 0.0, vGiant);
+    place(2, moonMass, giantR + moonR, 0.0, 0.0, vGiant + vMoon);
+    for (size_t k = 0; k < lightBodies; ++k) {
+        const double r = 3000.0 + 27000.0 * uni(rng), phase = 6.283185307179586 * uni(rng);
+        const double v = std::sqrt(muStar / r);
+        place(3 + k, 1e20, r * std::cos(phase), r * std::sin(phase), -v * std::sin(phase), v * std::cos(phase));
+    }
+}
+
+void PrintIntegratorReport() {
+    struct Case {
+        const char* name;
+        Integrator integrator;
+        bool block;
+    };
+    const Case cases[] = {
+        {"Leapfrog", Integrator::Leapfrog, false},
+        {"Yoshida4", Integrator::Yoshida4, false},
+        {"Hermite4 shared dt", Integrator::Hermite4, false},
+        {"Hermite4 block dt", Integrator::Hermite4, true},
+    };
+    const size_t lightBodies = 256;
+    const int steps = 480;  // 4 s de escena: ~90 órbitas del satélite
+
+    std::cout << "integrator\tms/step\t|dE/E|\tupdates/step" << std::endl;
+    for (const Case& c : cases) {
+        SimConfig cfg;
+        cfg.integrator = c.integrator;
+        cfg.blockTimesteps = c.block;
+        cfg.softening = 1.0f;
+        Simulation sim(cfg);
+        FillHierarchicalSystem(sim, lightBodies, 7u);
+        const double e0 = sim.Energy();
+
+        long long updates = 0;
+        auto t0 = std::chrono::steady_clock::now();
+        for (int k = 0; k < steps; ++k) {
+            sim.Step();
+            updates += sim.Stats().bodyUpdates;
+        }
+        auto t1 = std::chrono::steady_clock::now();
+        const double ms = std::chrono::duration<double, std::milli>(t1 - t0).count() / steps;
+        const double drift = std::abs((sim.Energy() - e0) / e0);
+        std::cout << c.name << "\t" << ms << "\t" << drift << "\t" << updates / steps << std::endl;
+    }
+}
+
+void PrintThreadScalingReport() {
+    const size_t n = 20000;
+    const unsigned maxThreads = std::max(1u, std::thread::hardware_concurrency());
+
+    std::vector<unsigned> counts;
+    for (unsigned t = 1; t < maxThreads; t *= 2) counts.push_back(t);
+    counts.push_back(maxThreads);
+
+    std::vector<float> reference;
+    double baseMs = 0.0;
+    std::cout << "threads\tms/step\tspeedup\tidentical" << std::endl;
+    for (unsigned t : counts) {
+        SimConfig cfg;
+        cfg.threads = t;
+        Simulation sim(cfg);
+        FillRandomCluster(sim, n, 99u);
+
+        auto t0 = std::chrono::steady_clock::now();
+        for (int k = 0; k < 3; ++k) sim.Step();
+        auto t1 = std::chrono::steady_clock::now();
+        double ms = std::chrono::duration<double, std::milli>(t1 - t0).count() / 3.0;
+        if (t == 1) baseMs = ms;
+
+        const BodySoA& b = sim.Bodies();
+        std::vector<float> state;
+        state.insert(state.end(), b.px.begin(), b.px.end());
+        state.insert(state.end(), b.vx.begin(), b.vx.end());
+        state.insert(state.end(), b.ax.begin(), b.ax.end());
+        if (reference.empty()) reference = state;
+        bool identical = std::memcmp(state.data(), reference.data(), state.size() * sizeof(float)) == 0;
+
+        std::cout << t << "\t" << ms << "\t" << baseMs / ms << "\t" << (identical ? "yes" : "NO") << std::endl;
+    }
+}
@@ -0,0 +1,137 @@
+// physics.h
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "object.h"
+#include "octree.h"
+#include "simd_gravity.h"
+#include "thread_pool.h"
+
+// Cálculo de fuerzas: suma directa exacta O(n^2) o árbol Barnes-Hut O(n log n)
+enum class ForceMode { Direct, BarnesHut };
+
+// Integrador:
+//  - Leapfrog: KDK de 2º orden, simpléctico, una evaluación de fuerzas por paso.
+//  - Yoshida4: composición de tres leapfrogs, 4º orden y simpléctico (3 evaluaciones).
+//  - Hermite4: predictor-corrector de 4º orden con jerk y pasos por cuerpo en
+//    bloques de potencias de dos: solo avanzan los cuerpos a los que les toca.
+//    Usa suma directa en doble (el jerk no sale del árbol Barnes-Hut).
+enum class Integrator { Leapfrog, Yoshida4, Hermite4 };
+const char* IntegratorName(Integrator integrator);
+
+// Parámetros de la simulación gravitatoria
+struct SimConfig {
+    float fixedDt = 1.0f / 120.0f;  // paso fijo en segundos de escena
+    double metersPerUnit = 1.0e5;   // 1 unidad de escena = 100 km
+    double timeScale = 2.2e4;       // segundos simulados por segundo de escena
+    float softening = 10.0f;        // suavizado en unidades, evita la singularidad r -> 0
+    ForceMode forceMode = ForceMode::Direct;
+    float theta = 0.5f;             // ángulo de apertura Barnes-Hut (0 = exacto)
+    unsigned threads = 0;           // hilos para fuerzas e integración (0 = todos los núcleos)
+    Integrator integrator = Integrator::Leapfrog;
+    float eta = 0.02f;              // Hermite: precisión del criterio de Aarseth
+    int maxBlockLevel = 10;         // Hermite: paso mínimo = fixedDt / 2^maxBlockLevel
+    bool blockTimesteps = true;     // Hermite: false = todos con el paso del más exigente
+};
+
+// Estado de los cuerpos como structure-of-arrays, listo para bucles vectorizables
+struct BodySoA {
+    std::vector<float> px, py, pz;
+    std::vector<float> vx, vy, vz;
+    std::vector<float> ax, ay, az;
+    std::vector<float> mass;            // kg
+    std::vector<float> mu;              // G*m en unidades de escena (u^3/s^2)
+    std::vector<unsigned char> pinned;  // cuerpos que atraen pero no se mueven
+
+    size_t Size() const { return px.size(); }
+    void Resize(size_t n);
+};
+
+// Métricas de rendimiento de la simulación
+struct SimStats {
+    size_t bodies = 0;
+    long long totalSteps = 0;
+    double lastStepMs = 0.0;
+    double stepsPerSecond = 0.0;  // pasos que caben en un segundo de CPU con la escena actual
+    int substeps = 0;             // Hermite: niveles de bloque recorridos en el último paso
+    long long bodyUpdates = 0;    // avances de cuerpo en el último paso (n por subpaso leapfrog)
+};
+
+// Motor N-body: paso fijo, integrador a elegir (leapfrog por defecto) y gravedad por pares.
+// El trabajo por cuerpo se reparte en el ThreadPool; cada cuerpo acumula su fuerza
+// siempre en el mismo orden, así que el resultado es idéntico con 1 o con 64 hilos.
+class Simulation {
+public:
+    explicit Simulation(const SimConfig& config = SimConfig());
+
+    // Copia objs -> SoA (y SoA -> objs tras avanzar)
+    void Sync(const std::vector<Object>& objs);
+    void WriteBack(std::vector<Object>& objs) const;
+
+    void Step();  // un paso fijo; el ritmo (y el tope por frame) lo lleva SimThread
+
+    // Aceleraciones de todos los cuerpos según el modo de fuerza activo
+    void ComputeAccelerations();
+    void ComputeAccelerationsDirect();
+    void ComputeAccelerationsBarnesHut();
+
+    void SetForceMode(ForceMode mode) { config.forceMode = mode; accelDirty = true; }
+    void SetTheta(float theta) { config.theta = theta; accelDirty = true; }
+    void SetSimdLevel(SimdLevel level) { simd = level; }
+    void SetThreadCount(unsigned threads) { config.threads = threads; pool.SetThreadCount(threads); }
+    void SetIntegrator(Integrator integrator) { config.integrator = integrator; accelDirty = true; }
+    const ThreadPool& Pool() const { return pool; }
+    ThreadPool& Pool() { return pool; }
+    SimdLevel GetSimdLevel() const { return simd; }
+
+    const BodySoA& Bodies() const { return bodies; }
+    BodySoA& Bodies() { return bodies; }
+    const SimStats& Stats() const { return stats; }
+    const SimConfig& Config() const { return config; }
+    double GravityScale() const { return gravityScale; }
+
+    // Energía total (cinética + potencial suavizado, en doble) en unidades de escena
+    // y kg: su deriva relativa mide la precisión del integrador. O(n^2).
+    double Energy() const;
+
+private:
+    SimConfig config;
+    BodySoA bodies;
+    SimStats stats;
+    Octree tree;
+    SimdLevel simd;
+    ThreadPool pool;
+
+    double gravityScale;  // G convertido a unidades de escena
+    bool accelDirty = true;
+    bool hermiteDirty = true;  // el SoA cambió por fuera (altas, fusiones, restauración): resembrar el doble
+
+    // Hermite en doble, persistente entre pasos. Los tiempos van en enteros, en
+    // unidades del paso mínimo (fixedDt / 2^maxBlockLevel): así los bloques coinciden exactamente.
+    struct HermiteState {
+        std::vector<double> x, y, z, vx, vy, vz;
+        std::vector<double> ax, ay, az, jx, jy, jz;  // en el último tiempo propio de cada cuerpo
+        std::vector<double> px, py, pz, pvx, pvy, pvz;  // predichos al subpaso actual
+        std::vector<double> nax, nay, naz, njx, njy, njz;  // recién evaluados, por activo
+        std::vector<uint32_t> time, step;
+        std::vector<uint32_t> active;
+        void Resize(size_t n);
+    };
+    HermiteState hermite;
+
+    void Leapfrog(float dt);
+    void StepHermite();
+    // a y jerk de los cuerpos de `active` a partir de las posiciones/velocidades predichas
+    void HermiteForces();
+};
+
+// Informe precisión-vs-velocidad de Barnes-Hut frente a suma directa
+void PrintForceAccuracyReport();
+
+// Deriva de energía frente a coste de cada integrador en un sistema jerárquico
+// (estrella, planetas, un satélite muy cerrado y cuerpos lejanos)
+void PrintIntegratorReport();
+
+// Tiempo por paso y speedup de 1 hilo a todos los núcleos, comprobando que el
+// resultado es bit a bit el mismo con cualquier número de hilos
+void PrintThreadScalingReport();
@@ -8,7 +8,7 @@
 static constexpr float DIST_SCALE = 1.0f / 5.0e7f;  // 1 unidad = 50 millones km
 static constexpr float BODY_SCALE = 400.0f;         // escala visual para cuerpos
 
-// Constructor: calcula radios, crea esfera y buffers
+// Constructor: calcula radios escalados (la geometría la pone SphereRenderer)
 CelestialBody::CelestialBody(glm::vec3 center,
                              float oRadius_km,
                              float mass,
@@ -26,50 +26,19 @@ CelestialBody::CelestialBody(glm::vec3 center,
     radius_km = std::cbrt((3.0f * mass) / (4.0f * glm::pi<float>() * density));
     scaledRadius = radius_km * BODY_SCALE * DIST_SCALE;
     scaledOrbitRadius = oRadius_km * DIST_SCALE;
-
-    auto vertices = CreateSphereVertices(scaledRadius, 36, 36);
-    vertexCount = vertices.size();
-
-    glGenVertexArrays(1, &VAO);
-    glGenBuffers(1, &VBO);
-    glBindVertexArray(VAO);
-
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
-
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), nullptr);
-
-    glBindVertexArray(0);
 }
 
-// Generación de esfera: triangulación UV
-std::vector<float> CelestialBody::CreateSphereVertices(float r, int stacks, int sectors) {
-    std::vector<float> vertices;
-    vertices.reserve(stacks * sectors * 6 * 3);
-    for (int i = 0; i < stacks; ++i) {
-        float theta1 = glm::pi<float>() * i / stacks;
-        float theta2 = glm::pi<float>() * (i + 1) / stacks;
-        for (int j = 0; j < sectors; ++j) {
-            float phi1 = 2.0f * glm::pi<float>() * j / sectors;
-            float phi2 = 2.0f * glm::pi<float>() * (j + 1) / sectors;
-
-            glm::vec3 v1 = sphericalToCartesian(r, theta1, phi1);
-            glm::vec3 v2 = sphericalToCartesian(r, theta1, phi2);
-            glm::vec3 v3 = sphericalToCartesian(r, theta2, phi1);
-            glm::vec3 v4 = sphericalToCartesian(r, theta2, phi2);
+void CelestialBody::SetOrbit(const OrbitalElements& el, float orbitScale) {
+    elements = el;
+    kmToScene = static_cast<double>(orbitScale) * DIST_SCALE;
+    keplerian = true;
+}
 
-            // Triángulo 1
-            vertices.insert(vertices.end(), {v1.x, v1.y, v1.z,
-                                             v2.x, v2.y, v2.z,
-                                             v3.x, v3.y, v3.z});
-            // Triángulo 2
-            vertices.insert(vertices.end(), {v2.x, v2.y, v2.z,
-                                             v4.x, v4.y, v4.z,
-                                             v3.x, v3.y, v3.z});
-        }
-    }
-    return vertices;
+// Posición en la órbita en km (doble); a float solo ya escalada a la escena
+void CelestialBody::SetOrbitPosition(double xKm, double yKm, double zKm) {
+    orbitOffset = glm::vec3(static_cast<float>(xKm * kmToScene),
+                            static_cast<float>(yKm * kmToScene),
+                            static_cast<float>(zKm * kmToScene));
 }
 
 // Actualiza ángulos de animación
@@ -86,28 +55,67 @@ glm::mat4 CelestialBody::GetModelMatrix() const {
     model = glm::translate(model, orbitCenter); // centro orbital (usualmente el Sol)
     model = glm::rotate(model, precession, glm::vec3(0, 1, 0));
     model = glm::rotate(model, nutationAmplitude * sin(nutation), glm::vec3(0, 0, 1));
-    model = glm::translate(model, glm::vec3(
-        scaledOrbitRadius * cos(orbitAngle),
-        0.0f,
-        scaledOrbitRadius * sin(orbitAngle)
-    ));
+    if (keplerian) {
+        model = glm::translate(model, orbitOffset);
+    } else {
+        model = glm::translate(model, glm::vec3(
+            scaledOrbitRadius * cos(orbitAngle),
+            0.0f,
+            scaledOrbitRadius * sin(orbitAngle)
+        ));
+    }
     model = glm::rotate(model, selfRotationAngle, glm::vec3(0, 1, 0));
     return model;
 }
 
-// Renderiza el planeta
-void CelestialBody::Draw(GLuint shader) const {
-    GLint colorLoc = glGetUniformLocation(shader, "objectColor");
-    glUniform4fv(colorLoc, 1, &color[0]);
-    glBindVertexArray(VAO);
-    glDrawArrays(GL_TRIANGLES, 0, vertexCount / 3);
-    glBindVertexArray(0);
+// Matriz para dibujar la esfera unitaria compartida con el radio del planeta
+glm::mat4 CelestialBody::GetInstanceMatrix() const {
+    return glm::scale(GetModelMatrix(), glm::vec3(scaledRadius));
+}
+
+CelestialBodyRecord CelestialBody::ToRecord() const {
+    CelestialBodyRecord r{};
+    r.center[0] = orbitCenter.x; r.center[1] = orbitCenter.y; r.center[2] = orbitCenter.z;
+    r.color[0] = color.r; r.color[1] = color.g; r.color[2] = color.b; r.color[3] = color.a;
+    r.mass = mass;
+    r.density = density;
+    r.radiusKm = radius_km;
+    r.scaledRadius = scaledRadius;
+    r.scaledOrbitRadius = scaledOrbitRadius;
+    r.orbitAngle = orbitAngle;
+    r.orbitSpeed = orbitSpeed;
+    r.selfRotationAngle = selfRotationAngle;
+    r.selfRotationSpeed = selfRotationSpeed;
+    r.precession = precession;
+    r.precessionSpeed = precessionSpeed;
+    r.nutation = nutation;
+    r.nutationSpeed = nutationSpeed;
+    r.nutationAmplitude = nutationAmplitude;
+    r.keplerian = keplerian ? 1u : 0u;
+    r.a = elements.a; r.e = elements.e; r.i = elements.i;
+    r.node = elements.node; r.peri = elements.peri; r.M0 = elements.M0; r.n = elements.n;
+    r.kmToScene = kmToScene;
+    return r;
 }
 
-// Convierte coordenadas esféricas a cartesianas
-glm::vec3 CelestialBody::sphericalToCartesian(float r, float theta, float phi) {
-    float x = r * sin(theta) * cos(phi);
-    float y = r * cos(theta);
-    float z = r * sin(theta) * sin(phi);
-    return glm::vec3(x, y, z);
+// Sin pasar por el constructor: los radios se restauran tal cual se guardaron
+CelestialBody CelestialBody::FromRecord(const CelestialBodyRecord& r) {
+    CelestialBody body(glm::vec3(r.center[0], r.center[1], r.center[2]), 0.0f, r.mass, r.density,
+                       glm::vec4(r.color[0], r.color[1], r.color[2], r.color[3]));
+    body.radius_km = r.radiusKm;
+    body.scaledRadius = r.scaledRadius;
+    body.scaledOrbitRadius = r.scaledOrbitRadius;
+    body.orbitAngle = r.orbitAngle;
+    body.orbitSpeed = r.orbitSpeed;
+    body.selfRotationAngle = r.selfRotationAngle;
+    body.selfRotationSpeed = r.selfRotationSpeed;
+    body.precession = r.precession;
+    body.precessionSpeed = r.precessionSpeed;
+    body.nutation = r.nutation;
+    body.nutationSpeed = r.nutationSpeed;
+    body.nutationAmplitude = r.nutationAmplitude;
+    body.keplerian = r.keplerian != 0;
+    body.elements = {r.a, r.e, r.i, r.node, r.peri, r.M0, r.n};
+    body.kmToScene = r.kmToScene;
+    return body;
 }
@@ -3,8 +3,23 @@
 
 #pragma once
 #include <glm/glm.hpp>
-#include <vector>
-#include <GL/glew.h>
+#include <cstdint>
+#include "kepler.h"
+
+// Todos los parámetros de un CelestialBody con disposición fija (snapshots binarios)
+struct CelestialBodyRecord {
+    float center[3];
+    float color[4];
+    float mass, density, radiusKm, scaledRadius, scaledOrbitRadius;
+    float orbitAngle, orbitSpeed;
+    float selfRotationAngle, selfRotationSpeed;
+    float precession, precessionSpeed;
+    float nutation, nutationSpeed, nutationAmplitude;
+    uint32_t keplerian;
+    double a, e, i, node, peri, M0, n;
+    double kmToScene;
+};
+static_assert(sizeof(CelestialBodyRecord) == 152, "CelestialBodyRecord es parte del formato de snapshot");
 
 class CelestialBody {
 public:
@@ -24,7 +39,9 @@ public:
 
     void UpdateAnimation(float dt);        // Actualiza ángulos
     glm::mat4 GetModelMatrix() const;      // Devuelve matriz de transformación
-    void Draw(GLuint shader) const;        // Dibuja el planeta
+    glm::mat4 GetInstanceMatrix() const;   // Modelo * escala por radio, para la esfera unitaria compartida
+    const glm::vec4& GetColor() const      { return color; }
+    float GetScaledRadius() const          { return scaledRadius; }
 
     // --- Setters de velocidades ---
     void SetOrbitSpeed(float radPerSec)         { orbitSpeed = radPerSec; }
@@ -33,11 +50,17 @@ public:
     void SetNutationSpeed(float radPerSec)      { nutationSpeed = radPerSec; }
     void SetNutationAmplitude(float rad)        { nutationAmplitude = rad; }
 
-    // OpenGL buffers
-    GLuint VAO = 0, VBO = 0;
+    // --- Órbita kepleriana (sustituye a la circular de orbitSpeed) ---
+    // orbitScale es la misma escala que se aplica al radio orbital del constructor
+    void SetOrbit(const OrbitalElements& elements, float orbitScale);
+    bool HasOrbit() const                       { return keplerian; }
+    const OrbitalElements& Orbit() const        { return elements; }
+    void SetOrbitPosition(double xKm, double yKm, double zKm);  // la calcula KeplerOrbits
+
+    CelestialBodyRecord ToRecord() const;
+    static CelestialBody FromRecord(const CelestialBodyRecord& record);
 
 private:
-    size_t vertexCount = 0;
     glm::vec4 color;
     glm::vec3 orbitCenter;
 
@@ -61,9 +84,10 @@ private:
     float nutationSpeed = 0.0f;
     float nutationAmplitude = 0.0f;
 
-    // Geometría
-    std::vector<float> CreateSphereVertices(float radius, int stacks, int sectors);
-    glm::vec3 sphericalToCartesian(float r, float theta, float phi);
+    bool keplerian = false;
+    OrbitalElements elements;
+    double kmToScene = 0.0;
+    glm::vec3 orbitOffset = glm::vec3(0.0f);
 };
 
 #endif // PLANET_H
@@ -0,0 +1,210 @@
+// profiler.cpp
+#include "profiler.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <map>
+
+Profiler profiler;
+
+// Identificador corto por hilo para las pistas del trace (0 = el primero en medir)
+static uint16_t ThreadIndex() {
+    static std::atomic<uint16_t> nextThread{0};
+    thread_local uint16_t index = nextThread.fetch_add(1, std::memory_order_relaxed);
+    return index;
+}
+
+static const uint16_t GPU_TRACK = 1000;
+
+Profiler::Profiler() : ring(new Slot[RING_CAPACITY]) {
+    originNs = NowNs();
+}
+
+Profiler::~Profiler() = default;
+
+uint64_t Profiler::NowNs() const {
+    uint64_t now = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+    return now - originNs;
+}
+
+void Profiler::Record(const char* name, uint64_t startNs, uint64_t durationNs, bool gpu) {
+    Push(name, startNs, durationNs, frame.load(std::memory_order_relaxed), gpu);
+}
+
+void Profiler::Push(const char* name, uint64_t startNs, uint64_t durationNs, uint32_t sampleFrame, bool gpu) {
+    if (!enabled) return;
+    // Reserva un hueco con fetch_add; sequence se publica al final para que el
+    // lector distinga huecos completos de los que otro hilo está escribiendo
+    uint64_t index = writeIndex.fetch_add(1, std::memory_order_relaxed);
+    Slot& slot = ring[index & (RING_CAPACITY - 1)];
+    slot.sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.sample.name = name;
+    slot.sample.startNs = startNs;
+    slot.sample.durationNs = durationNs;
+    slot.sample.frame = sampleFrame;
+    slot.sample.thread = gpu ? GPU_TRACK : ThreadIndex();
+    slot.sample.gpu = gpu;
+    slot.sequence.store(index + 1, std::memory_order_release);
+}
+
+std::vector<ProfileSample> Profiler::Snapshot() const {
+    std::vector<ProfileSample> samples;
+    uint64_t end = writeIndex.load(std::memory_order_acquire);
+    uint64_t begin = end > RING_CAPACITY ? end - RING_CAPACITY : 0;
+    samples.reserve(static_cast<size_t>(end - begin));
+    for (uint64_t i = begin; i < end; ++i) {
+        const Slot& slot = ring[i & (RING_CAPACITY - 1)];
+        if (slot.sequence.load(std::memory_order_acquire) != i + 1) continue;
+        ProfileSample copy = slot.sample;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        // Si otro hilo lo pisó mientras copiábamos, se descarta
+        if (slot.sequence.load(std::memory_order_relaxed) == i + 1) samples.push_back(copy);
+    }
+    std::sort(samples.begin(), samples.end(),
+              [](const ProfileSample& a, const ProfileSample& b) { return a.startNs < b.startNs; });
+    return samples;
+}
+
+void Profiler::BeginFrame() {
+    frameStartNs = NowNs();
+}
+
+void Profiler::EndFrame() {
+    uint64_t end = NowNs();
+    if (enabled) {
+        Record("frame", frameStartNs, end - frameStartNs);
+        frameMs.push_back((end - frameStartNs) / 1e6);
+    }
+    CollectGpu();
+    ++frame;
+}
+
+void Profiler::BeginGpu(const char* name) {
+    if (!enabled || openQuery.id != 0) return;
+    if (freeQueries.empty()) {
+        GLuint ids[8];
+        glGenQueries(8, ids);
+        freeQueries.insert(freeQueries.end(), ids, ids + 8);
+    }
+    openQuery.id = freeQueries.back();
+    freeQueries.pop_back();
+    openQuery.name = name;
+    openQuery.issuedNs = NowNs();
+    openQuery.frame = frame.load(std::memory_order_relaxed);
+    glBeginQuery(GL_TIME_ELAPSED, openQuery.id);
+}
+
+void Profiler::EndGpu() {
+    if (openQuery.id == 0) return;
+    glEndQuery(GL_TIME_ELAPSED);
+    pendingQueries.push_back(openQuery);
+    openQuery = GpuQuery();
+}
+
+// Sin bloquear: solo se leen las consultas cuyo resultado ya está disponible
+void Profiler::CollectGpu() {
+    size_t kept = 0;
+    for (size_t i = 0; i < pendingQueries.size(); ++i) {
+        GpuQuery& q = pendingQueries[i];
+        GLint available = GL_FALSE;
+        glGetQueryObjectiv(q.id, GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) {
+            pendingQueries[kept++] = q;
+            continue;
+        }
+        GLuint64 elapsed = 0;
+        glGetQueryObjectui64v(q.id, GL_QUERY_RESULT, &elapsed);
+        // La muestra pertenece al frame en que se emitió, no al actual
+        Push(q.name, q.issuedNs, elapsed, q.frame, true);
+        freeQueries.push_back(q.id);
+    }
+    pendingQueries.resize(kept);
+}
+
+void Profiler::ReleaseGpu() {
+    if (openQuery.id != 0) EndGpu();
+    for (const GpuQuery& q : pendingQueries) freeQueries.push_back(q.id);
+    pendingQueries.clear();
+    if (!freeQueries.empty()) glDeleteQueries(static_cast<GLsizei>(freeQueries.size()), freeQueries.data());
+    freeQueries.clear();
+}
+
+bool Profiler::ExportChromeTrace(const std::string& path) const {
+    std::ofstream out(path, std::ios::trunc);
+    if (!out) {
+        std::cerr << "Could not write trace " << path << std::endl;
+        return false;
+    }
+    std::vector<ProfileSample> samples = Snapshot();
+    out << "{\"traceEvents\":[\n";
+    out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << GPU_TRACK
+        << ",\"args\":{\"name\":\"GPU\"}}";
+    out.setf(std::ios::fixed);
+    out.precision(3);
+    for (const ProfileSample& s : samples) {
+        out << ",\n{\"name\":\"" << s.name << "\",\"cat\":\"" << (s.gpu ? "gpu" : "cpu")
+            << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << s.thread
+            << ",\"ts\":" << s.startNs / 1000.0 << ",\"dur\":" << s.durationNs / 1000.0
+            << ",\"args\":{\"frame\":" << s.frame << "}}";
+    }
+    out << "\n]}\n";
+    std::cout << "Trace: " << samples.size() << " samples -> " << path << std::endl;
+    return static_cast<bool>(out);
+}
+
+bool Profiler::ExportCsv(const std::string& path) const {
+    std::ofstream out(path, std::ios::trunc);
+    if (!out) {
+        std::cerr << "Could not write profile " << path << std::endl;
+        return false;
+    }
+    out << "frame,name,kind,thread,start_us,duration_us\n";
+    out.setf(std::ios::fixed);
+    out.precision(3);
+    for (const ProfileSample& s : Snapshot()) {
+        out << s.frame << "," << s.name << "," << (s.gpu ? "gpu" : "cpu") << "," << s.thread << ","
+            << s.startNs / 1000.0 << "," << s.durationNs / 1000.0 << "\n";
+    }
+    return static_cast<bool>(out);
+}
+
+void Profiler::PrintSummary() const {
+    if (frameMs.empty()) return;
+    std::vector<double> sorted = frameMs;
+    std::sort(sorted.begin(), sorted.end());
+    auto percentile = [&sorted](double p) {
+        return sorted[std::min(sorted.size() - 1, static_cast<size_t>(p * sorted.size()))];
+    };
+    double total = 0.0;
+    for (double ms : sorted) total += ms;
+    double mean = total / sorted.size();
+    std::cout << "[profile] frames=" << sorted.size()
+              << " mean=" << mean << " ms"
+              << " p50=" << percentile(0.50) << " ms"
+              << " p95=" << percentile(0.95) << " ms"
+              << " p99=" << percentile(0.99) << " ms"
+              << " max=" << sorted.back() << " ms"
+              << " fps=" << 1000.0 / mean << std::endl;
+
+    // Media por frame de cada fase, sobre los frames que siguen en el anillo
+    std::vector<ProfileSample> samples = Snapshot();
+    if (samples.empty()) return;
+    uint32_t firstFrame = samples.front().frame, lastFrame = samples.front().frame;
+    std::map<std::string, double> cpuNs, gpuNs;
+    for (const ProfileSample& s : samples) {
+        firstFrame = std::min(firstFrame, s.frame);
+        lastFrame = std::max(lastFrame, s.frame);
+        if (std::string(s.name) == "frame") continue;
+        (s.gpu ? gpuNs : cpuNs)[s.name] += static_cast<double>(s.durationNs);
+    }
+    double frames = lastFrame - firstFrame + 1.0;
+    std::cout << "[profile] phase\tcpu_ms\tgpu_ms" << std::endl;
+    for (const auto& [name, ns] : cpuNs) {
+        auto gpu = gpuNs.find(name);
+        std::cout << "[profile] " << name << "\t" << ns / frames / 1e6 << "\t"
+                  << (gpu == gpuNs.end() ? 0.0 : gpu->second / frames / 1e6) << std::endl;
+    }
+}
@@ -0,0 +1,108 @@
+// profiler.h
+#pragma once
+#include <GL/glew.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Una medición: CPU (hilo que la tomó) o GPU (consulta GL_TIME_ELAPSED)
+struct ProfileSample {
+    const char* name = nullptr;  // literal: vive todo el programa
+    uint64_t startNs = 0;        // desde que arrancó el profiler
+    uint64_t durationNs = 0;
+    uint32_t frame = 0;
+    uint16_t thread = 0;
+    bool gpu = false;
+};
+
+// Profiler de frame. Las muestras van a un anillo sin locks (cualquier hilo puede
+// escribir; al llenarse pisa las más viejas) y se exportan a Chrome trace
+// (chrome://tracing, Perfetto) o CSV. Los tiempos de GPU se piden con consultas
+// GL_TIME_ELAPSED y se recogen frames después, solo cuando ya están disponibles.
+class Profiler {
+public:
+    static constexpr size_t RING_CAPACITY = 1 << 16;  // potencia de 2
+
+    Profiler();
+    ~Profiler();
+
+    void SetEnabled(bool on) { enabled = on; }
+    bool Enabled() const { return enabled; }
+
+    void BeginFrame();
+    void EndFrame();  // cierra el frame y recoge las consultas de GPU terminadas
+    uint32_t Frame() const { return frame.load(std::memory_order_relaxed); }
+
+    uint64_t NowNs() const;
+    void Record(const char* name, uint64_t startNs, uint64_t durationNs, bool gpu = false);
+
+    // Una sola consulta de GPU abierta a la vez (GL no anida GL_TIME_ELAPSED)
+    void BeginGpu(const char* name);
+    void EndGpu();
+    void ReleaseGpu();  // borra las consultas (antes de destruir el contexto)
+
+    bool ExportChromeTrace(const std::string& path) const;
+    bool ExportCsv(const std::string& path) const;
+    // Percentiles del tiempo de frame y media por fase
+    void PrintSummary() const;
+
+private:
+    struct Slot {
+        ProfileSample sample;
+        std::atomic<uint64_t> sequence{0};  // índice de escritura + 1 cuando está completo
+    };
+    struct GpuQuery {
+        GLuint id = 0;
+        const char* name = nullptr;
+        uint64_t issuedNs = 0;
+        uint32_t frame = 0;
+    };
+
+    bool enabled = true;
+    std::unique_ptr<Slot[]> ring;
+    std::atomic<uint64_t> writeIndex{0};
+    uint64_t originNs = 0;
+
+    std::atomic<uint32_t> frame{0};  // lo leen los hilos que graban muestras
+    uint64_t frameStartNs = 0;
+    std::vector<double> frameMs;  // todos los frames (solo hilo principal)
+
+    std::vector<GLuint> freeQueries;
+    std::vector<GpuQuery> pendingQueries;
+    GpuQuery openQuery;
+
+    void Push(const char* name, uint64_t startNs, uint64_t durationNs, uint32_t sampleFrame, bool gpu);
+    std::vector<ProfileSample> Snapshot() const;
+    void CollectGpu();
+};
+
+extern Profiler profiler;
+
+// Mide el bloque actual en CPU
+class ScopedTimer {
+public:
+    explicit ScopedTimer(const char* name) : name(name), start(profiler.NowNs()) {}
+    ~ScopedTimer() { profiler.Record(name, start, profiler.NowNs() - start); }
+
+private:
+    const char* name;
+    uint64_t start;
+};
+
+// Mide el bloque actual en CPU y en GPU (pases de dibujo)
+class ScopedGpuTimer {
+public:
+    explicit ScopedGpuTimer(const char* name) : cpu(name) { profiler.BeginGpu(name); }
+    ~ScopedGpuTimer() { profiler.EndGpu(); }
+
+private:
+    ScopedTimer cpu;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(name) ScopedTimer PROFILE_CONCAT(profileScope, __LINE__)(name)
+#define PROFILE_GPU_SCOPE(name) ScopedGpuTimer PROFILE_CONCAT(profileGpuScope, __LINE__)(name)
@@ -0,0 +1,203 @@
+// quadtree.cpp
+#include "quadtree.h"
+#include <algorithm>
+#include <cmath>
+
+// Una celda dividida se vuelve a fundir solo si su error cae por debajo de la mitad
+// de la tolerancia (sus hijas tienen ~1/4 del error): evita oscilar frame a frame
+static constexpr float MERGE_FACTOR = 0.5f;
+
+void GridQuadtree::Init(float size, int depth, size_t vertexBudget) {
+    maxDepth = std::clamp(depth, 1, 15);
+    unit = size / static_cast<float>(1u << maxDepth);
+    origin = -size / 2.0f;
+    budget = std::max<size_t>(vertexBudget, 4);
+    fitted = false;
+    Reset();
+}
+
+void GridQuadtree::Reset() {
+    nodes.clear();
+    freeBlocks.clear();
+    nodes.push_back({0u, 0u, 0, -1});
+    leaves = 1;
+}
+
+float GridQuadtree::CellError(const Node& node, const GridWell* wells, size_t n, float planeY) const {
+    const float size = Span(node) * unit;
+    const float x0 = origin + node.ix * unit;
+    const float z0 = origin + node.iz * unit;
+    float curvature = 0.0f;
+    for (size_t b = 0; b < n; ++b) {
+        // Punto de la celda más cercano al cuerpo (el plano está a planeY)
+        float dx = wells[b].x - std::clamp(wells[b].x, x0, x0 + size);
+        float dz = wells[b].z - std::clamp(wells[b].z, z0, z0 + size);
+        float dy = wells[b].y - planeY;
+        float d = std::max(std::sqrt(dx * dx + dy * dy + dz * dz), 1.0f);
+        curvature += wells[b].k / (d * std::sqrt(d));
+    }
+    return size * size * 0.125f * curvature;
+}
+
+void GridQuadtree::Split(int index) {
+    int first;
+    if (!freeBlocks.empty()) {
+        first = freeBlocks.back();
+        freeBlocks.pop_back();
+    } else {
+        first = static_cast<int>(nodes.size());
+        nodes.resize(nodes.size() + 4);
+    }
+    const Node parent = nodes[index];
+    const uint32_t half = Span(parent) / 2;
+    const unsigned char depth = static_cast<unsigned char>(parent.depth + 1);
+    for (int q = 0; q < 4; ++q)
+        nodes[first + q] = {parent.ix + (q & 1 ? half : 0u), parent.iz + (q & 2 ? half : 0u), depth, -1};
+    nodes[index].child = first;
+    leaves += 3;
+}
+
+void GridQuadtree::Merge(int index) {
+    freeBlocks.push_back(nodes[index].child);
+    nodes[index].child = -1;
+    leaves -= 3;
+}
+
+bool GridQuadtree::RefineNode(int index, const GridWell* wells, size_t n, float planeY,
+                              size_t& ops, size_t maxOps) {
+    bool changed = false;
+    if (nodes[index].child < 0) {
+        if (nodes[index].depth >= maxDepth || ops >= maxOps || leaves + 3 > budget) return false;
+        if (CellError(nodes[index], wells, n, planeY) <= tolerance) return false;
+        Split(index);
+        ++ops;
+        changed = true;
+    }
+
+    const int first = nodes[index].child;  // Split puede mover el vector: se lee después
+    bool childrenAreLeaves = true;
+    for (int q = 0; q < 4; ++q) {
+        changed |= RefineNode(first + q, wells, n, planeY, ops, maxOps);
+        childrenAreLeaves &= nodes[first + q].child < 0;
+    }
+
+    if (childrenAreLeaves && ops < maxOps &&
+        CellError(nodes[index], wells, n, planeY) < tolerance * MERGE_FACTOR) {
+        Merge(index);
+        ++ops;
+        changed = true;
+    }
+    return changed;
+}
+
+bool GridQuadtree::Refine(const GridWell* wells, size_t n, float planeY, size_t maxOps) {
+    size_t ops = 0;
+    return RefineNode(0, wells, n, planeY, ops, maxOps);
+}
+
+void GridQuadtree::Fit(const GridWell* wells, size_t n, float planeY) {
+    // Bisección en escala logarítmica: la tolerancia más baja que cabe en el presupuesto
+    const size_t target = budget;
+    budget = target + 1;  // un árbol que llega al tope se considera "no cabe"
+    Reset();
+    float hi = std::max(CellError(nodes[0], wells, n, planeY), 1e-6f);
+    float lo = hi * 1e-12f;
+    for (int it = 0; it < 40 && hi / lo > 1.01f; ++it) {
+        tolerance = std::sqrt(lo * hi);
+        Reset();
+        size_t ops = 0;
+        RefineNode(0, wells, n, planeY, ops, static_cast<size_t>(-1));
+        if (leaves + 3 > target) lo = tolerance;
+        else hi = tolerance;
+    }
+    budget = target;
+    tolerance = hi;
+    Reset();
+    size_t ops = 0;
+    RefineNode(0, wells, n, planeY, ops, static_cast<size_t>(-1));
+    fitted = true;
+}
+
+GridQuadtree::Cell GridQuadtree::FindCell(float x, float z) const {
+    const Node* node = &nodes[0];
+    while (node->child >= 0) {
+        const uint32_t half = Span(*node) / 2;
+        int q = (x >= origin + (node->ix + half) * unit ? 1 : 0)
+              | (z >= origin + (node->iz + half) * unit ? 2 : 0);
+        node = &nodes[node->child + q];
+    }
+    return {origin + node->ix * unit, origin + node->iz * unit, Span(*node) * unit};
+}
+
+void GridQuadtree::Emit(std::vector<float>& vx, std::vector<float>& vz, std::vector<uint32_t>& indices) const {
+    const uint32_t side = 1u << maxDepth;
+    auto key = [side](uint32_t ix, uint32_t iz) { return static_cast<uint64_t>(ix) * (side + 1) + iz; };
+
+    // Hojas (recorrido sin recursión)
+    std::vector<int> leafList;
+    leafList.reserve(leaves);
+    std::vector<int> stack = {0};
+    while (!stack.empty()) {
+        int i = stack.back();
+        stack.pop_back();
+        if (nodes[i].child < 0) leafList.push_back(i);
+        else for (int q = 3; q >= 0; --q) stack.push_back(nodes[i].child + q);
+    }
+
+    // Tabla hash abierta esquina -> índice: se rehace en cada cambio de topología,
+    // y un unordered_map aquí cuesta más que todo el refinado
+    size_t capacity = 16;
+    while (capacity < leafList.size() * 4) capacity <<= 1;
+    const uint64_t EMPTY = ~0ull;
+    std::vector<uint64_t> keys(capacity, EMPTY);
+    std::vector<uint32_t> values(capacity);
+    auto slot = [&](uint64_t k) {
+        size_t h = static_cast<size_t>((k * 0x9E3779B97F4A7C15ull) >> 20) & (capacity - 1);
+        while (keys[h] != EMPTY && keys[h] != k) h = (h + 1) & (capacity - 1);
+        return h;
+    };
+
+    vx.clear(); vz.clear();
+    vx.reserve(leafList.size() + leafList.size() / 8);
+    vz.reserve(vx.capacity());
+    auto addVertex = [&](uint32_t ix, uint32_t iz) {
+        size_t h = slot(key(ix, iz));
+        if (keys[h] != EMPTY) return;
+        keys[h] = key(ix, iz);
+        values[h] = static_cast<uint32_t>(vx.size());
+        vx.push_back(origin + ix * unit);
+        vz.push_back(origin + iz * unit);
+    };
+    for (int i : leafList) {
+        const Node& n = nodes[i];
+        const uint32_t s = Span(n);
+        addVertex(n.ix, n.iz); addVertex(n.ix + s, n.iz);
+        addVertex(n.ix, n.iz + s); addVertex(n.ix + s, n.iz + s);
+    }
+
+    // Aristas: si el punto medio es vértice de una vecina más fina, se parte en dos.
+    // Cada hoja emite solo su arista inferior e izquierda (y las del borde superior/
+    // derecho del plano): la vecina de arriba o de la derecha cubre el resto, sin duplicados.
+    indices.clear();
+    indices.reserve(leafList.size() * 4 + 2 * side);
+    auto edge = [&](auto&& self, uint32_t ax, uint32_t az, uint32_t bx, uint32_t bz) -> void {
+        if (bx - ax + bz - az > 1) {
+            uint32_t mx = (ax + bx) / 2, mz = (az + bz) / 2;
+            if (keys[slot(key(mx, mz))] != EMPTY) {
+                self(self, ax, az, mx, mz);
+                self(self, mx, mz, bx, bz);
+                return;
+            }
+        }
+        indices.push_back(values[slot(key(ax, az))]);
+        indices.push_back(values[slot(key(bx, bz))]);
+    };
+    for (int i : leafList) {
+        const Node& n = nodes[i];
+        const uint32_t s = Span(n);
+        edge(edge, n.ix, n.iz, n.ix + s, n.iz);
+        edge(edge, n.ix, n.iz, n.ix, n.iz + s);
+        if (n.iz + s == side) edge(edge, n.ix, n.iz + s, n.ix + s, n.iz + s);
+        if (n.ix + s == side) edge(edge, n.ix + s, n.iz, n.ix + s, n.iz + s);
+    }
+}
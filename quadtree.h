@@ -0,0 +1,61 @@
+// quadtree.h
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Pozo de potencial visto desde el plano de la malla: posición del cuerpo y
+// coeficiente k de la curvatura, |h''(d)| ~ k * d^-1.5 a distancia d.
+struct GridWell {
+    float x, y, z, k;
+};
+
+// Quadtree sobre el plano de la malla espacio-temporal. Las celdas se dividen
+// donde el error de interpolación lineal (size^2/8 * |h''|) supera la tolerancia
+// y se funden cuando vuelve a caer por debajo, así que al moverse los cuerpos
+// solo cambian las celdas cercanas. Coordenadas enteras en unidades de la celda
+// más fina: los vértices compartidos se deduplican de forma exacta.
+class GridQuadtree {
+public:
+    struct Node {
+        uint32_t ix, iz;      // esquina mínima en unidades de la celda más fina
+        unsigned char depth;
+        int child;            // primero de 4 hijos contiguos, -1 si es hoja
+    };
+
+    struct Cell {
+        float x0, z0, size;
+    };
+
+    void Init(float size, int maxDepth, size_t vertexBudget);
+
+    // Busca la tolerancia que deja el árbol cerca del presupuesto de vértices y lo construye
+    void Fit(const GridWell* wells, size_t n, float planeY);
+    // Divide/funde como mucho maxOps celdas; true si cambió la topología
+    bool Refine(const GridWell* wells, size_t n, float planeY, size_t maxOps);
+
+    // Vértices únicos (x, z) y segmentos GL_LINES; las aristas de una celda
+    // gruesa se parten en los vértices colgantes de sus vecinas finas.
+    void Emit(std::vector<float>& vx, std::vector<float>& vz, std::vector<uint32_t>& indices) const;
+
+    Cell FindCell(float x, float z) const;  // hoja que contiene el punto
+    size_t LeafCount() const { return leaves; }
+    float Tolerance() const { return tolerance; }
+    bool Fitted() const { return fitted; }
+
+private:
+    std::vector<Node> nodes;
+    std::vector<int> freeBlocks;  // bloques de 4 hijos liberados al fundir
+    float origin = 0.0f, unit = 1.0f;
+    int maxDepth = 0;
+    size_t budget = 0, leaves = 1;
+    float tolerance = 1.0f;
+    bool fitted = false;
+
+    void Reset();
+    float CellError(const Node& node, const GridWell* wells, size_t n, float planeY) const;
+    bool RefineNode(int index, const GridWell* wells, size_t n, float planeY, size_t& ops, size_t maxOps);
+    void Split(int index);
+    void Merge(int index);
+    uint32_t Span(const Node& node) const { return 1u << (maxDepth - node.depth); }
+};
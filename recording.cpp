@@ -0,0 +1,432 @@
+// recording.cpp
+#include "recording.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+TrajectoryPlayer replayer;
+
+static const char RECORDING_MAGIC[8] = {'G', 'R', 'A', 'V', 'R', 'E', 'C', '\0'};
+static const uint8_t CHUNK_KEY = 1, CHUNK_DELTA = 2;
+static const size_t META_PER_BODY = 6;  // masa, radio, rgba
+static const size_t ANGLES_PER_PLANET = 3;  // precesión, inclinación, giro propio
+
+// Cuanto de cada valor: posiciones hasta `positionCoords`, ángulos después
+static double QuantumOf(size_t k, size_t positionCoords, double quantum) {
+    return k < positionCoords ? quantum : RECORDING_ANGLE_QUANTUM;
+}
+
+// Misma rotación que CelestialBody::GetInstanceMatrix, con la traslación ya resuelta
+static glm::mat4 PlanetMatrix(const glm::vec3& position, const float* angles, float radius) {
+    glm::mat4 m = glm::rotate(glm::mat4(1.0f), angles[0], glm::vec3(0, 1, 0));
+    m = glm::rotate(m, angles[1], glm::vec3(0, 0, 1));
+    m = glm::rotate(m, angles[2], glm::vec3(0, 1, 0));
+    m = glm::scale(m, glm::vec3(radius));
+    m[3] = glm::vec4(position, 1.0f);
+    return m;
+}
+
+static void PutVarint(std::vector<uint8_t>& bytes, int64_t value) {
+    uint64_t v = (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);  // zigzag
+    while (v >= 0x80) {
+        bytes.push_back(static_cast<uint8_t>(v) | 0x80);
+        v >>= 7;
+    }
+    bytes.push_back(static_cast<uint8_t>(v));
+}
+
+static bool GetVarint(const uint8_t*& p, const uint8_t* end, int64_t& value) {
+    uint64_t v = 0;
+    for (int shift = 0; p < end && shift < 64; shift += 7) {
+        uint8_t b = *p++;
+        v |= static_cast<uint64_t>(b & 0x7f) << shift;
+        if (!(b & 0x80)) {
+            value = static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1);
+            return true;
+        }
+    }
+    return false;
+}
+
+template <typename T>
+static void PutRaw(std::vector<uint8_t>& bytes, const T* data, size_t count) {
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(data);
+    bytes.insert(bytes.end(), p, p + count * sizeof(T));
+}
+
+template <typename T>
+static bool GetRaw(const uint8_t*& p, const uint8_t* end, T* data, size_t count) {
+    size_t bytes = count * sizeof(T);
+    if (static_cast<size_t>(end - p) < bytes) return false;
+    std::memcpy(data, p, bytes);
+    p += bytes;
+    return true;
+}
+
+// --- Grabación ---
+
+TrajectoryRecorder::~TrajectoryRecorder() {
+    Close();
+}
+
+bool TrajectoryRecorder::Open(const std::string& file, double tickSeconds, double q) {
+    Close();
+    if constexpr (std::endian::native != std::endian::little) {
+        std::cerr << "Recordings are little-endian; this host is not" << std::endl;
+        return false;
+    }
+    out.open(file, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        std::cerr << "Could not write recording " << file << std::endl;
+        return false;
+    }
+    RecordingHeader header{};
+    std::memcpy(header.magic, RECORDING_MAGIC, sizeof(header.magic));
+    header.version = RECORDING_VERSION;
+    header.keyframeInterval = KEYFRAME_INTERVAL;
+    header.quantum = q;
+    header.tickSeconds = tickSeconds;
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    path = file;
+    quantum = q;
+    history = 0;
+    bytesWritten = sizeof(header);
+    bodyTicks = framesWritten = captured = dropped = 0;
+    failed = false;
+    forceKey = true;
+    closing = false;
+    writer = std::thread(&TrajectoryRecorder::WriterLoop, this);
+    return true;
+}
+
+void TrajectoryRecorder::Close() {
+    if (!writer.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        closing = true;
+    }
+    ready.notify_one();
+    writer.join();
+    out.close();
+    std::cout << "[record] " << path << ": " << framesWritten << " frames (" << dropped << " dropped), "
+              << bytesWritten / 1e6 << " MB, "
+              << (bodyTicks ? static_cast<double>(bytesWritten) / bodyTicks : 0.0) << " bytes per body-tick"
+              << std::endl;
+    queue.clear();
+    freeFrames.clear();
+    allocated = 0;
+}
+
+void TrajectoryRecorder::Capture(const std::vector<Object>& objs, const std::vector<CelestialBody>& planets,
+                                 const glm::vec3& shipPosition, const glm::vec3& shipDirection,
+                                 uint64_t tick, double orbitTime) {
+    std::unique_ptr<Frame> frame;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!freeFrames.empty()) {
+            frame = std::move(freeFrames.back());
+            freeFrames.pop_back();
+        } else if (allocated < MAX_PENDING) {
+            frame = std::make_unique<Frame>();
+            ++allocated;
+        }
+    }
+    ++captured;
+    if (!frame) {
+        // El escritor va atrasado: sin frame anterior no hay delta válido
+        ++dropped;
+        forceKey = true;
+        return;
+    }
+
+    const size_t tracks = objs.size() + planets.size() + 1;
+    frame->key = forceKey || tracks != lastTracks || sinceKey >= KEYFRAME_INTERVAL;
+    frame->tick = tick;
+    frame->orbitTime = orbitTime;
+    frame->objCount = static_cast<uint32_t>(objs.size());
+    frame->planetCount = static_cast<uint32_t>(planets.size());
+    frame->positions.resize(tracks * 3);
+    float* p = frame->positions.data();
+    for (const Object& o : objs) { *p++ = o.position.x; *p++ = o.position.y; *p++ = o.position.z; }
+    frame->angles.resize(planets.size() * ANGLES_PER_PLANET + 3);
+    float* a = frame->angles.data();
+    for (const CelestialBody& planet : planets) {
+        const glm::vec4 position = planet.GetInstanceMatrix()[3];
+        *p++ = position.x; *p++ = position.y; *p++ = position.z;
+        const CelestialBodyRecord r = planet.ToRecord();
+        *a++ = r.precession; *a++ = r.nutationAmplitude * std::sin(r.nutation); *a++ = r.selfRotationAngle;
+    }
+    *p++ = shipPosition.x; *p++ = shipPosition.y; *p++ = shipPosition.z;
+    *a++ = shipDirection.x; *a++ = shipDirection.y; *a++ = shipDirection.z;
+
+    if (frame->key) {
+        frame->meta.resize(objs.size() * META_PER_BODY);
+        float* m = frame->meta.data();
+        for (const Object& o : objs) {
+            *m++ = o.mass; *m++ = o.radius;
+            *m++ = o.color.r; *m++ = o.color.g; *m++ = o.color.b; *m++ = o.color.a;
+        }
+        frame->planetColors.resize(planets.size());
+        frame->planetRadii.resize(planets.size());
+        for (size_t i = 0; i < planets.size(); ++i) {
+            frame->planetColors[i] = planets[i].GetColor();
+            frame->planetRadii[i] = planets[i].GetScaledRadius();
+        }
+        sinceKey = 0;
+    }
+    ++sinceKey;
+    lastTracks = tracks;
+    forceKey = false;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        queue.push_back(std::move(frame));
+    }
+    ready.notify_one();
+}
+
+void TrajectoryRecorder::WriterLoop() {
+    for (;;) {
+        std::unique_ptr<Frame> frame;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            ready.wait(lock, [this] { return closing || !queue.empty(); });
+            if (queue.empty()) return;  // closing y nada pendiente
+            frame = std::move(queue.front());
+            queue.pop_front();
+        }
+        Encode(*frame);
+        std::lock_guard<std::mutex> lock(mutex);
+        freeFrames.push_back(std::move(frame));
+    }
+}
+
+void TrajectoryRecorder::Encode(const Frame& frame) {
+    if (failed) return;
+    const size_t coords = frame.positions.size();
+    values.assign(frame.positions.begin(), frame.positions.end());
+    values.insert(values.end(), frame.angles.begin(), frame.angles.end());
+    const size_t count = values.size();
+    payload.clear();
+    if (frame.key) {
+        uint32_t counts[2] = {frame.objCount, frame.planetCount};
+        PutRaw(payload, counts, 2);
+        PutRaw(payload, values.data(), count);
+        PutRaw(payload, frame.meta.data(), frame.meta.size());
+        PutRaw(payload, frame.planetRadii.data(), frame.planetRadii.size());
+        PutRaw(payload, frame.planetColors.data(), frame.planetColors.size());
+        q1.resize(count);
+        for (size_t k = 0; k < count; ++k) q1[k] = std::llround(values[k] / QuantumOf(k, coords, quantum));
+        history = 1;
+    } else {
+        q2.resize(count);
+        for (size_t k = 0; k < count; ++k) {
+            int64_t q = std::llround(values[k] / QuantumOf(k, coords, quantum));
+            int64_t predicted = history >= 2 ? 2 * q1[k] - q2[k] : q1[k];
+            PutVarint(payload, q - predicted);
+            q2[k] = q1[k];
+            q1[k] = q;
+        }
+        history = 2;
+    }
+
+    RecordingChunk chunk{};
+    chunk.type = frame.key ? CHUNK_KEY : CHUNK_DELTA;
+    chunk.payloadBytes = static_cast<uint32_t>(payload.size());
+    chunk.tick = frame.tick;
+    chunk.orbitTime = frame.orbitTime;
+    out.write(reinterpret_cast<const char*>(&chunk), sizeof(chunk));
+    out.write(reinterpret_cast<const char*>(payload.data()), payload.size());
+    if (!out) {
+        std::cerr << "Could not write recording " << path << std::endl;
+        failed = true;
+        return;
+    }
+    bytesWritten += sizeof(chunk) + payload.size();
+    bodyTicks += frame.objCount;
+    ++framesWritten;
+}
+
+// --- Reproducción ---
+
+bool TrajectoryPlayer::Open(const std::string& file) {
+    Close();
+    in.open(file, std::ios::binary);
+    if (!in || !in.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        std::memcmp(header.magic, RECORDING_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != RECORDING_VERSION || header.quantum <= 0.0) {
+        std::cerr << "Invalid recording " << file << std::endl;
+        Close();
+        return false;
+    }
+
+    // Índice leyendo solo las cabeceras de los frames (un archivo cortado a
+    // mitad de frame se abre hasta el último completo)
+    in.seekg(0, std::ios::end);
+    const uint64_t fileSize = static_cast<uint64_t>(in.tellg());
+    uint64_t offset = sizeof(header), bodyTicks = 0;
+    uint32_t objCount = 0;
+    while (offset + sizeof(RecordingChunk) <= fileSize) {
+        RecordingChunk chunk;
+        in.seekg(static_cast<std::streamoff>(offset));
+        if (!in.read(reinterpret_cast<char*>(&chunk), sizeof(chunk))) break;
+        if (offset + sizeof(chunk) + chunk.payloadBytes > fileSize) break;
+        const bool key = chunk.type == CHUNK_KEY;
+        if (key && !in.read(reinterpret_cast<char*>(&objCount), sizeof(objCount))) break;
+        if (index.empty() && !key) break;
+        if (key) keyOf.push_back(static_cast<uint32_t>(index.size()));
+        else keyOf.push_back(keyOf.back());
+        index.push_back({offset, key});
+        bodyTicks += objCount;
+        offset += sizeof(chunk) + chunk.payloadBytes;
+    }
+    in.clear();
+    if (index.empty()) {
+        std::cerr << "Recording " << file << " has no frames" << std::endl;
+        Close();
+        return false;
+    }
+    std::cout << "[replay] " << file << ": " << index.size() << " frames, "
+              << index.size() * header.tickSeconds << " s, "
+              << (bodyTicks ? static_cast<double>(offset) / bodyTicks : 0.0) << " bytes per body-tick"
+              << std::endl;
+    decoded = -1;
+    SetPlayhead(0.0);
+    return true;
+}
+
+void TrajectoryPlayer::Close() {
+    in.close();
+    in.clear();
+    index.clear();
+    keyOf.clear();
+    decoded = -1;
+    playhead = 0.0;
+    world = WorldSnapshot();
+}
+
+bool TrajectoryPlayer::DecodeNext() {
+    const Entry& entry = index[static_cast<size_t>(decoded + 1)];
+    RecordingChunk chunk;
+    in.seekg(static_cast<std::streamoff>(entry.offset));
+    if (!in.read(reinterpret_cast<char*>(&chunk), sizeof(chunk))) return false;
+    payload.resize(chunk.payloadBytes);
+    if (!in.read(reinterpret_cast<char*>(payload.data()), payload.size())) return false;
+    const uint8_t* p = payload.data();
+    const uint8_t* end = p + payload.size();
+
+    previous.swap(current);
+    previousValid = decoded >= 0;
+    if (entry.key) {
+        uint32_t counts[2];
+        if (!GetRaw(p, end, counts, 2)) return false;
+        const size_t objCount = counts[0], planetCount = counts[1];
+        const size_t coords = (objCount + planetCount + 1) * 3;
+        const size_t count = coords + planetCount * ANGLES_PER_PLANET + 3;
+        current.resize(count);
+        std::vector<float> meta(objCount * META_PER_BODY);
+        planetRadii.resize(planetCount);
+        world.planets.resize(planetCount);
+        world.planetColors.resize(planetCount);
+        if (!GetRaw(p, end, current.data(), count) || !GetRaw(p, end, meta.data(), meta.size()) ||
+            !GetRaw(p, end, planetRadii.data(), planetCount) ||
+            !GetRaw(p, end, world.planetColors.data(), planetCount))
+            return false;
+        positionCoords = coords;
+        // Cuerpos con lo que no cambia entre keyframes (la grid usa la masa)
+        world.objs.clear();
+        world.objs.reserve(objCount);
+        for (size_t i = 0; i < objCount; ++i) {
+            const float* m = &meta[i * META_PER_BODY];
+            world.objs.emplace_back(glm::vec3(0.0f), glm::vec3(0.0f), m[0]);
+            world.objs.back().radius = m[1];
+            world.objs.back().color = glm::vec4(m[2], m[3], m[4], m[5]);
+        }
+        q1.resize(count);
+        for (size_t k = 0; k < count; ++k) q1[k] = std::llround(current[k] / QuantumOf(k, coords, header.quantum));
+        history = 1;
+        previousValid = previousValid && previous.size() == count;
+    } else {
+        const size_t count = q1.size();
+        current.resize(count);
+        q2.resize(count);
+        for (size_t k = 0; k < count; ++k) {
+            int64_t residual;
+            if (!GetVarint(p, end, residual)) return false;
+            int64_t q = residual + (history >= 2 ? 2 * q1[k] - q2[k] : q1[k]);
+            q2[k] = q1[k];
+            q1[k] = q;
+            current[k] = static_cast<float>(q * QuantumOf(k, positionCoords, header.quantum));
+        }
+        history = 2;
+    }
+    world.tick = chunk.tick;
+    previousOrbitTime = world.orbitTime;
+    world.orbitTime = chunk.orbitTime;
+    ++decoded;
+    return true;
+}
+
+void TrajectoryPlayer::DecodeTo(size_t frame) {
+    // Hacia atrás, o más allá del keyframe siguiente, es un salto; avanzar al
+    // frame contiguo no lo es aunque sea keyframe. Un salto se reanuda desde el
+    // keyframe de frame - 1 para que previous vuelva a ser el frame anterior.
+    if (decoded < 0 || static_cast<long long>(frame) < decoded ||
+        static_cast<long long>(keyOf[frame]) > decoded + 1) {
+        const size_t start = keyOf[frame > 0 ? frame - 1 : 0];
+        decoded = static_cast<long long>(start) - 1;
+        if (!DecodeNext()) {
+            std::cerr << "Corrupt recording frame " << start << std::endl;
+            return;
+        }
+        previousValid = false;  // el anterior no es el frame contiguo
+    }
+    while (decoded < static_cast<long long>(frame)) {
+        if (!DecodeNext()) {
+            std::cerr << "Corrupt recording frame " << decoded + 1 << std::endl;
+            return;
+        }
+    }
+}
+
+void TrajectoryPlayer::SetPlayhead(double frame) {
+    if (index.empty()) return;
+    const double last = static_cast<double>(index.size() - 1);
+    playhead = std::clamp(frame, 0.0, last);
+    const size_t f0 = static_cast<size_t>(playhead);
+    const size_t f1 = std::min(f0 + 1, index.size() - 1);
+    DecodeTo(f1);
+    alpha = f1 == f0 ? 1.0f : static_cast<float>(playhead - f0);
+
+    // Snapshot entre f0 (previous) y f1 (current), con el mismo formato que publica SimThread
+    const std::vector<float>& from = previousValid && f1 != f0 ? previous : current;
+    const size_t objCount = world.objs.size(), planetCount = world.planets.size();
+    world.simTime = world.tick * header.tickSeconds;
+    world.prevPositions.resize(objCount);
+    for (size_t i = 0; i < objCount; ++i) {
+        world.objs[i].position = glm::vec3(current[i * 3], current[i * 3 + 1], current[i * 3 + 2]);
+        world.prevPositions[i] = glm::vec3(from[i * 3], from[i * 3 + 1], from[i * 3 + 2]);
+    }
+    world.prevPlanetPositions.resize(planetCount);
+    for (size_t i = 0; i < planetCount; ++i) {
+        const size_t k = (objCount + i) * 3;
+        const float* angles = &current[positionCoords + i * ANGLES_PER_PLANET];
+        world.planets[i] = PlanetMatrix(glm::vec3(current[k], current[k + 1], current[k + 2]), angles, planetRadii[i]);
+        world.prevPlanetPositions[i] = glm::vec3(from[k], from[k + 1], from[k + 2]);
+    }
+    const size_t ship = (objCount + planetCount) * 3;
+    const size_t shipAngles = positionCoords + planetCount * ANGLES_PER_PLANET;
+    world.shipPosition = glm::vec3(current[ship], current[ship + 1], current[ship + 2]);
+    world.shipDirection = glm::vec3(current[shipAngles], current[shipAngles + 1], current[shipAngles + 2]);
+    world.prevShipPosition = glm::vec3(from[ship], from[ship + 1], from[ship + 2]);
+    world.prevOrbitTime = previousValid && f1 != f0 ? previousOrbitTime : world.orbitTime;
+}
+
+void TrajectoryPlayer::Advance(double seconds) {
+    if (paused || index.empty()) return;
+    SetPlayhead(playhead + seconds * speed / header.tickSeconds);
+}
@@ -0,0 +1,159 @@
+// recording.h
+#pragma once
+#include <glm/glm.hpp>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "object.h"
+#include "planet.h"
+#include "sim_thread.h"
+
+// Grabación de trayectorias (little-endian): cabecera y una secuencia de frames.
+// Cada KEYFRAME_INTERVAL ticks (o si cambia el número de cuerpos) va un keyframe
+// con el estado completo en float; entre medias, posiciones cuantizadas a
+// `quantum` unidades y codificadas como residuo de una predicción lineal
+// (2*q[t-1] - q[t-2]) en varints zigzag. Error máximo: quantum / 2.
+// Con las posiciones viajan, igual codificados, los ángulos de cada planeta
+// (precesión, inclinación por nutación y giro propio) y la dirección de la nave,
+// así su orientación avanza en cada frame y no solo en los keyframes.
+constexpr uint32_t RECORDING_VERSION = 2;
+constexpr uint32_t KEYFRAME_INTERVAL = 120;
+constexpr double DEFAULT_RECORDING_QUANTUM = 1e-3;  // unidades de escena (100 m)
+constexpr double RECORDING_ANGLE_QUANTUM = 1e-5;    // radianes (y componentes de la dirección)
+
+struct RecordingHeader {
+    char magic[8];  // "GRAVREC\0"
+    uint32_t version;
+    uint32_t keyframeInterval;
+    double quantum;
+    double tickSeconds;
+};
+
+struct RecordingChunk {
+    uint8_t type;  // 1 keyframe, 2 delta
+    uint8_t pad[3];
+    uint32_t payloadBytes;
+    uint64_t tick;
+    double orbitTime;
+};
+
+// Lado de grabación: Capture() copia posiciones en un frame de un pool y lo
+// encola; un hilo propio codifica y escribe. Si el escritor no da abasto se
+// descartan frames (y el siguiente es keyframe) en vez de frenar la simulación.
+class TrajectoryRecorder {
+public:
+    static constexpr size_t MAX_PENDING = 64;
+
+    ~TrajectoryRecorder();
+
+    bool Open(const std::string& path, double tickSeconds, double quantum = DEFAULT_RECORDING_QUANTUM);
+    void Close();  // vacía la cola e informa bytes por cuerpo-tick
+    bool IsOpen() const { return writer.joinable(); }
+
+    void Capture(const std::vector<Object>& objs, const std::vector<CelestialBody>& planets,
+                 const glm::vec3& shipPosition, const glm::vec3& shipDirection,
+                 uint64_t tick, double orbitTime);
+
+private:
+    struct Frame {
+        bool key = false;
+        uint64_t tick = 0;
+        double orbitTime = 0.0;
+        uint32_t objCount = 0, planetCount = 0;
+        std::vector<float> positions;  // xyz: objs, planetas y la nave
+        std::vector<float> angles;     // 3 por planeta y la dirección de la nave
+        std::vector<float> meta;       // solo keyframes: masa, radio y color por cuerpo
+        std::vector<float> planetRadii;
+        std::vector<glm::vec4> planetColors;
+    };
+
+    // Lado captura (hilo de simulación)
+    uint32_t sinceKey = 0;
+    size_t lastTracks = 0;
+    bool forceKey = true;
+    uint64_t captured = 0, dropped = 0;
+
+    std::mutex mutex;
+    std::condition_variable ready;
+    std::deque<std::unique_ptr<Frame>> queue;
+    std::vector<std::unique_ptr<Frame>> freeFrames;
+    size_t allocated = 0;
+    bool closing = false;
+    std::thread writer;
+
+    // Lado escritor
+    std::ofstream out;
+    std::string path;
+    double quantum = DEFAULT_RECORDING_QUANTUM;
+    std::vector<int64_t> q1, q2;  // posiciones y ángulos cuantizados de los dos frames anteriores
+    int history = 0;
+    std::vector<uint8_t> payload;
+    std::vector<float> values;    // posiciones seguidas de ángulos
+    uint64_t bytesWritten = 0, bodyTicks = 0, framesWritten = 0;
+    bool failed = false;
+
+    void WriterLoop();
+    void Encode(const Frame& frame);
+};
+
+// Reproducción: lee los frames en streaming (un índice de offsets, sin cargar
+// el archivo) y decodifica desde el keyframe más cercano. Avanzar cuesta un
+// frame de decodificación; retroceder o saltar, como mucho un intervalo de keyframes.
+class TrajectoryPlayer {
+public:
+    bool Open(const std::string& path);
+    void Close();
+    bool IsOpen() const { return !index.empty(); }
+
+    size_t FrameCount() const { return index.size(); }
+    double TickSeconds() const { return header.tickSeconds; }
+
+    // Cabezal en frames (fraccionario: se interpola entre dos)
+    void SetPlayhead(double frame);
+    double Playhead() const { return playhead; }
+    void Advance(double seconds);  // según la velocidad; negativa = hacia atrás
+    void SetSpeed(double s) { speed = s; }
+    double Speed() const { return speed; }
+    void TogglePause() { paused = !paused; }
+
+    const WorldSnapshot& Snapshot() const { return world; }
+    float Alpha() const { return alpha; }
+
+private:
+    struct Entry {
+        uint64_t offset;
+        bool key;
+    };
+
+    std::ifstream in;
+    RecordingHeader header{};
+    std::vector<Entry> index;
+    std::vector<uint32_t> keyOf;  // keyframe del que depende cada frame
+
+    double playhead = 0.0, speed = 1.0;
+    bool paused = false;
+    float alpha = 1.0f;
+
+    // Estado decodificado
+    long long decoded = -1;
+    std::vector<int64_t> q1, q2;
+    int history = 0;
+    size_t positionCoords = 0;         // en current/previous van primero las posiciones y luego los ángulos
+    std::vector<float> current, previous;
+    std::vector<float> planetRadii;
+    double previousOrbitTime = 0.0;
+    bool previousValid = false;
+    std::vector<uint8_t> payload;
+    WorldSnapshot world;
+
+    bool DecodeNext();
+    void DecodeTo(size_t frame);
+};
+
+extern TrajectoryPlayer replayer;
@@ -0,0 +1,227 @@
+// render_queue.cpp
+#include "render_queue.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+void RenderQueue::Init(bool allowIndirect) {
+    // El comando indirecto lleva baseInstance: MDI no basta, hace falta también base
+    // instance (GL 4.2 o ARB_base_instance); si no, se reapuntan los atributos a mano
+    indirect = allowIndirect && (GLEW_VERSION_4_3 ||
+        (GLEW_ARB_multi_draw_indirect && (GLEW_VERSION_4_2 || GLEW_ARB_base_instance)));
+    if (indirect) glGenBuffers(1, &indirectBuffer);
+    std::cout << "[render] queue: " << (indirect ? "multi-draw-indirect" : "direct draws") << std::endl;
+}
+
+void RenderQueue::Destroy() {
+    if (indirectBuffer) glDeleteBuffers(1, &indirectBuffer);
+    indirectBuffer = 0;
+    indirectCapacity = 0;
+    packets.clear();
+}
+
+void RenderQueue::Submit(const DrawPacket& packet) {
+    if (packet.material && packet.count > 0 && packet.instanceCount > 0) packets.push_back(packet);
+}
+
+// 24 bits altos del float: para distancias >= 0 el patrón de bits es monótono
+static uint64_t DepthBits(float depth) {
+    depth = std::max(depth, 0.0f);
+    uint32_t bits;
+    std::memcpy(&bits, &depth, sizeof(bits));
+    return bits >> 8;
+}
+
+// capa(1) | sin mezcla primero(1) | opacos: programa(12) VAO(12) profundidad(24)
+//                                  | transparentes: lejanía(24) programa(12) VAO(12)
+uint64_t RenderQueue::SortKey(const DrawPacket& p) {
+    const uint64_t layer = static_cast<uint64_t>(p.layer);
+    const uint64_t blend = p.material->blend ? 1 : 0;
+    const uint64_t program = p.material->program->Id() & 0xFFF;
+    const uint64_t vao = p.vao & 0xFFF;
+    const uint64_t depth = DepthBits(p.depth);
+    uint64_t key = layer << 63 | blend << 62;
+    if (p.layer == RenderLayer::Opaque) key |= program << 50 | vao << 38 | depth << 14;
+    else key |= (0xFFFFFFu - depth) << 38 | program << 26 | vao << 14;
+    return key;
+}
+
+bool RenderQueue::SameRun(const DrawPacket& a, const DrawPacket& b) {
+    return a.material == b.material && a.vao == b.vao && a.mode == b.mode && a.indexType == b.indexType;
+}
+
+static size_t IndexSize(GLenum type) {
+    return type == GL_UNSIGNED_BYTE ? 1 : type == GL_UNSIGNED_SHORT ? 2 : 4;
+}
+
+// Lo que hacía cada renderer al dibujar por su cuenta, en el orden de envío
+void RenderQueue::CountUnsorted() {
+    for (size_t i = 0; i < packets.size();) {
+        const DrawPacket& p = packets[i];
+        size_t j = i + 1;
+        while (j < packets.size() && SameRun(p, packets[j])) ++j;
+        bool plain = !p.material->instanceOffset;
+        for (size_t k = i; k < j; ++k) plain = plain && packets[k].instanceCount == 1;
+        size_t changes = 3 + (p.material->apply ? 1 : 0);  // Use, apply, VAO y desenlazar
+        size_t draws = plain ? 1 : j - i;
+        if (p.material->instanceOffset) changes += j - i;
+        stats.unsortedStateChanges += changes;
+        stats.unsortedApiCalls += changes + draws;
+        i = j;
+    }
+}
+
+void RenderQueue::Flush() {
+    stats = RenderQueueStats();
+    stats.packets = packets.size();
+    if (packets.empty()) return;
+    CountUnsorted();
+
+    keys.resize(packets.size());
+    order.resize(packets.size());
+    for (size_t i = 0; i < packets.size(); ++i) {
+        keys[i] = SortKey(packets[i]);
+        order[i] = static_cast<uint32_t>(i);
+    }
+    // Estable: a igual clave se respeta el orden de envío
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return keys[a] < keys[b]; });
+
+    // Tramos con el mismo material, VAO y primitiva; con MDI, sus comandos seguidos
+    runs.clear();
+    commands.clear();
+    for (size_t i = 0; i < order.size();) {
+        const DrawPacket& first = packets[order[i]];
+        size_t j = i + 1;
+        while (j < order.size() && SameRun(first, packets[order[j]])) ++j;
+        runs.push_back({i, j, commands.size() * sizeof(GLuint)});
+        if (indirect) {
+            for (size_t k = i; k < j; ++k) {
+                const DrawPacket& p = packets[order[k]];
+                // DrawElementsIndirectCommand / DrawArraysIndirectCommand
+                if (p.indexType) commands.insert(commands.end(), {p.count, p.instanceCount, p.first, 0u, p.baseInstance});
+                else commands.insert(commands.end(), {p.count, p.instanceCount, p.first, p.baseInstance});
+            }
+        }
+        i = j;
+    }
+    if (indirect) {
+        // Buffer nuevo con la capacidad reservada y subida solo de los comandos de este frame
+        const size_t bytes = commands.size() * sizeof(GLuint);
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, indirectBuffer);
+        if (bytes > indirectCapacity) indirectCapacity = bytes * 2;
+        glBufferData(GL_DRAW_INDIRECT_BUFFER, static_cast<GLsizeiptr>(indirectCapacity), nullptr, GL_STREAM_DRAW);
+        glBufferSubData(GL_DRAW_INDIRECT_BUFFER, 0, static_cast<GLsizeiptr>(bytes), commands.data());
+        stats.apiCalls += 3;
+    }
+
+    // Estado actual; al empezar se asume el de StartGLU (mezcla activa, profundidad escribible)
+    const RenderMaterial* material = nullptr;
+    GLuint program = ~0u, vao = 0;  // el programa activo es desconocido; el VAO, el 0
+    bool blend = true, depthWrite = true;
+    for (const Run& run : runs) {
+        const DrawPacket& p = packets[order[run.begin]];
+        const RenderMaterial& m = *p.material;
+        if (&m != material) {
+            if (m.program->Id() != program) {
+                m.program->Use();
+                program = m.program->Id();
+                stats.programBinds++;
+                stats.stateChanges++;
+                stats.apiCalls++;
+            }
+            if (m.apply) {
+                m.apply();
+                stats.stateChanges++;
+                stats.apiCalls++;
+            }
+            if (m.blend != blend) {
+                if (m.blend) glEnable(GL_BLEND);
+                else glDisable(GL_BLEND);
+                blend = m.blend;
+                stats.stateChanges++;
+                stats.apiCalls++;
+            }
+            if (m.depthWrite != depthWrite) {
+                glDepthMask(m.depthWrite ? GL_TRUE : GL_FALSE);
+                depthWrite = m.depthWrite;
+                stats.stateChanges++;
+                stats.apiCalls++;
+            }
+            material = &m;
+        }
+        if (p.vao != vao) {
+            glBindVertexArray(p.vao);
+            vao = p.vao;
+            stats.vaoBinds++;
+            stats.stateChanges++;
+            stats.apiCalls++;
+        }
+        DrawRun(run);
+    }
+
+    glBindVertexArray(0);
+    if (!blend) glEnable(GL_BLEND);
+    if (!depthWrite) glDepthMask(GL_TRUE);
+    stats.apiCalls += 1 + (blend ? 0 : 1) + (depthWrite ? 0 : 1);
+    packets.clear();
+}
+
+void RenderQueue::DrawRun(const Run& run) {
+    const DrawPacket& first = packets[order[run.begin]];
+    const GLsizei n = static_cast<GLsizei>(run.end - run.begin);
+    stats.drawCalls++;
+    stats.apiCalls++;
+    if (indirect) {
+        stats.multiDraws++;
+        const void* offset = reinterpret_cast<const void*>(run.commandOffset);
+        if (first.indexType) glMultiDrawElementsIndirect(first.mode, first.indexType, offset, n, 0);
+        else glMultiDrawArraysIndirect(first.mode, offset, n, 0);
+        return;
+    }
+
+    // Sin indirecto: los tramos sin instancias van en un glMultiDraw*
+    const RenderMaterial& m = *first.material;
+    bool plain = !m.instanceOffset;
+    for (size_t k = run.begin; k < run.end && plain; ++k) plain = packets[order[k]].instanceCount == 1;
+    if (plain && n > 1) {
+        stats.multiDraws++;
+        counts.clear();
+        if (first.indexType) {
+            offsets.clear();
+            for (size_t k = run.begin; k < run.end; ++k) {
+                const DrawPacket& p = packets[order[k]];
+                counts.push_back(static_cast<GLsizei>(p.count));
+                offsets.push_back(reinterpret_cast<const void*>(p.first * IndexSize(p.indexType)));
+            }
+            glMultiDrawElements(first.mode, counts.data(), first.indexType, offsets.data(), n);
+        } else {
+            firsts.clear();
+            for (size_t k = run.begin; k < run.end; ++k) {
+                const DrawPacket& p = packets[order[k]];
+                firsts.push_back(static_cast<GLint>(p.first));
+                counts.push_back(static_cast<GLsizei>(p.count));
+            }
+            glMultiDrawArrays(first.mode, firsts.data(), counts.data(), n);
+        }
+        return;
+    }
+
+    // Una llamada por paquete; las instancias se reapuntan a mano si hace falta
+    stats.drawCalls += n - 1;
+    stats.apiCalls += n - 1;
+    for (size_t k = run.begin; k < run.end; ++k) {
+        const DrawPacket& p = packets[order[k]];
+        if (m.instanceOffset) {
+            m.instanceOffset(p.baseInstance);
+            stats.stateChanges++;
+            stats.apiCalls++;
+        }
+        const GLsizei count = static_cast<GLsizei>(p.count), instances = static_cast<GLsizei>(p.instanceCount);
+        if (p.indexType) {
+            const void* offset = reinterpret_cast<const void*>(p.first * IndexSize(p.indexType));
+            glDrawElementsInstanced(p.mode, count, p.indexType, offset, instances);
+        } else {
+            glDrawArraysInstanced(p.mode, static_cast<GLint>(p.first), count, instances);
+        }
+    }
+}
@@ -0,0 +1,94 @@
+// render_queue.h
+#pragma once
+#include <GL/glew.h>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "shader.h"
+
+// Capa de dibujo: primero lo opaco, después lo transparente
+enum class RenderLayer : uint8_t { Opaque = 0, Transparent = 1 };
+
+// Estado que comparten los paquetes de un renderer: programa, mezcla, escritura
+// de profundidad y los uniforms, que `apply` fija al activarlo. Vive en el
+// renderer y se rellena al enviar, así que basta con que dure hasta Flush().
+struct RenderMaterial {
+    const ShaderProgram* program = nullptr;
+    bool blend = true;
+    bool depthWrite = true;
+    std::function<void()> apply;
+    // Sin base instance (GL 3.3 puro): reapunta los atributos de instancia a
+    // partir de esa instancia. Solo lo necesitan los paquetes instanciados.
+    std::function<void(GLuint)> instanceOffset;
+};
+
+// Una llamada de dibujo: qué se dibuja (VAO, primitiva, rango) y con qué material.
+// indexType = 0 es sin índices (first es vértice); si no, first es índice.
+struct DrawPacket {
+    const RenderMaterial* material = nullptr;
+    GLuint vao = 0;
+    GLenum mode = GL_TRIANGLES;
+    GLenum indexType = 0;
+    GLuint first = 0, count = 0;
+    GLuint instanceCount = 1, baseInstance = 0;
+    RenderLayer layer = RenderLayer::Opaque;
+    float depth = 0.0f;  // distancia a la cámara: opacos de cerca a lejos, transparentes al revés
+};
+
+// Lo que costó el último Flush() y lo que habría costado dibujar cada renderer
+// por su cuenta (Use + uniforms + VAO + draw + desenlazar, sin agrupar entre ellos)
+struct RenderQueueStats {
+    size_t packets = 0;
+    size_t drawCalls = 0;       // llamadas glDraw* / glMultiDraw*
+    size_t multiDraws = 0;      // de ellas, indirectas o glMultiDraw*
+    size_t programBinds = 0;
+    size_t vaoBinds = 0;
+    size_t stateChanges = 0;    // programa + material + VAO + mezcla + profundidad
+    size_t apiCalls = 0;        // todas las llamadas GL de la cola (un apply cuenta 1)
+    size_t unsortedStateChanges = 0;
+    size_t unsortedApiCalls = 0;
+};
+
+// Cola de dibujo del frame: los renderers envían paquetes, Flush() los ordena
+// por una clave de 64 bits (capa, material, VAO, profundidad) y dibuja cada
+// tramo con el mismo material y VAO en una sola llamada: glMulti*Indirect si hay
+// GL 4.3 (o ARB_multi_draw_indirect con base instance), si no glMultiDraw* o una
+// llamada por paquete.
+// El estado se cachea durante el Flush: no se repite ningún Use ni bind.
+class RenderQueue {
+public:
+    void Init(bool allowIndirect = true);
+    void Destroy();
+
+    void Submit(const DrawPacket& packet);
+    void Flush();  // deja el VAO 0, la mezcla activa y la profundidad escribible
+
+    bool Indirect() const { return indirect; }
+    const RenderQueueStats& Stats() const { return stats; }
+
+private:
+    struct Run {
+        size_t begin, end;      // en `order`
+        size_t commandOffset;   // en bytes, dentro del buffer indirecto
+    };
+
+    bool indirect = false;
+    GLuint indirectBuffer = 0;
+    size_t indirectCapacity = 0;  // bytes
+
+    std::vector<DrawPacket> packets;
+    std::vector<uint64_t> keys;
+    std::vector<uint32_t> order;
+    std::vector<Run> runs;
+    std::vector<GLuint> commands;
+    std::vector<GLint> firsts;
+    std::vector<GLsizei> counts;
+    std::vector<const void*> offsets;
+    RenderQueueStats stats;
+
+    static uint64_t SortKey(const DrawPacket& p);
+    static bool SameRun(const DrawPacket& a, const DrawPacket& b);
+    void CountUnsorted();
+    void DrawRun(const Run& run);
+};
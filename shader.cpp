@@ -0,0 +1,159 @@
+// shader.cpp
+#include "shader.h"
+#include "functions.h"
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <glm/gtc/type_ptr.hpp>
+
+static const char* SHADER_CACHE_DIR = "shader_cache";
+
+// FNV-1a: la clave del caché cambia si cambia el código o el driver
+static uint64_t HashString(uint64_t h, const char* s) {
+    for (; s && *s; ++s) {
+        h ^= static_cast<unsigned char>(*s);
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+bool ShaderProgram::Build(const char* vSrc, const char* fSrc, const char* cacheName,
+                          const char* feedbackVarying) {
+    Destroy();
+    bool canCache = cacheName != nullptr && GLEW_ARB_get_program_binary;
+
+    std::string path;
+    if (canCache) {
+        uint64_t h = 14695981039346656037ull;
+        h = HashString(h, vSrc);
+        h = HashString(h, fSrc);
+        h = HashString(h, feedbackVarying);
+        h = HashString(h, reinterpret_cast<const char*>(glGetString(GL_RENDERER)));
+        h = HashString(h, reinterpret_cast<const char*>(glGetString(GL_VERSION)));
+        std::ostringstream name;
+        name << SHADER_CACHE_DIR << "/" << cacheName << "_" << std::hex << h << ".bin";
+        path = name.str();
+        loadedFromCache = LoadBinary(path);
+    }
+
+    if (!loadedFromCache) {
+        id = CreateShaderProgram(vSrc, fSrc, canCache, feedbackVarying);
+        GLint linked = GL_FALSE;
+        glGetProgramiv(id, GL_LINK_STATUS, &linked);
+        if (!linked) return false;
+        if (canCache) SaveBinary(path);
+    }
+
+    // Bloque de cámara (si el programa lo usa) enlazado al UBO compartido
+    BindBlock("Camera", CAMERA_UBO_BINDING);
+
+    CacheUniforms();
+    return true;
+}
+
+void ShaderProgram::Destroy() {
+    if (id) glDeleteProgram(id);
+    id = 0;
+    loadedFromCache = false;
+    uniforms.clear();
+}
+
+// Recorre los uniforms activos una vez tras enlazar; después no hay más glGetUniformLocation
+void ShaderProgram::CacheUniforms() {
+    uniforms.clear();
+    GLint count = 0, maxLen = 0;
+    glGetProgramiv(id, GL_ACTIVE_UNIFORMS, &count);
+    glGetProgramiv(id, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLen);
+    std::vector<char> buffer(std::max(maxLen, 1));
+    for (GLint i = 0; i < count; ++i) {
+        GLsizei len = 0;
+        GLint size = 0;
+        GLenum type = 0;
+        glGetActiveUniform(id, static_cast<GLuint>(i), maxLen, &len, &size, &type, buffer.data());
+        std::string name(buffer.data(), len);
+        GLint loc = glGetUniformLocation(id, name.c_str());
+        if (loc < 0) continue;  // miembros de bloques uniformes
+        // Los arrays se listan como "nombre[0]"; se guarda también "nombre"
+        size_t bracket = name.find('[');
+        if (bracket != std::string::npos) uniforms[name.substr(0, bracket)] = loc;
+        uniforms[name] = loc;
+    }
+}
+
+void ShaderProgram::BindBlock(const char* blockName, GLuint binding) const {
+    GLuint block = glGetUniformBlockIndex(id, blockName);
+    if (block != GL_INVALID_INDEX) glUniformBlockBinding(id, block, binding);
+}
+
+GLint ShaderProgram::Uniform(const std::string& name) const {
+    auto it = uniforms.find(name);
+    return it == uniforms.end() ? -1 : it->second;
+}
+
+bool ShaderProgram::LoadBinary(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return false;
+    GLenum format = 0;
+    if (!in.read(reinterpret_cast<char*>(&format), sizeof(format))) return false;
+    // istreambuf_iterator no marca eof: basta con que quede algo tras el formato
+    std::vector<char> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    if (data.empty()) return false;
+
+    id = glCreateProgram();
+    glProgramBinary(id, format, data.data(), static_cast<GLsizei>(data.size()));
+    GLint linked = GL_FALSE;
+    glGetProgramiv(id, GL_LINK_STATUS, &linked);
+    if (!linked) {
+        // Binario de otro driver o corrupto: se recompila desde el código
+        glDeleteProgram(id);
+        id = 0;
+        return false;
+    }
+    return true;
+}
+
+// Escribe en un temporal y renombra, para no dejar binarios a medias
+void ShaderProgram::SaveBinary(const std::string& path) const {
+    GLint length = 0;
+    glGetProgramiv(id, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) return;
+    std::vector<char> data(length);
+    GLenum format = 0;
+    glGetProgramBinary(id, length, nullptr, &format, data.data());
+
+    std::error_code ec;
+    std::filesystem::create_directories(SHADER_CACHE_DIR, ec);
+    std::string tmp = path + ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (!out) return;
+        out.write(reinterpret_cast<const char*>(&format), sizeof(format));
+        out.write(data.data(), data.size());
+        if (!out) return;
+    }
+    std::filesystem::rename(tmp, path, ec);
+    if (ec) std::cerr << "Could not write shader cache " << path << ": " << ec.message() << std::endl;
+}
+
+void CameraBlock::Init() {
+    glGenBuffers(1, &ubo);
+    glBindBuffer(GL_UNIFORM_BUFFER, ubo);
+    glBufferData(GL_UNIFORM_BUFFER, 2 * sizeof(glm::mat4), nullptr, GL_DYNAMIC_DRAW);
+    glBindBufferBase(GL_UNIFORM_BUFFER, CAMERA_UBO_BINDING, ubo);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+void CameraBlock::Update(const glm::mat4& view, const glm::mat4& projection) {
+    glBindBuffer(GL_UNIFORM_BUFFER, ubo);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(glm::mat4), glm::value_ptr(view));
+    glBufferSubData(GL_UNIFORM_BUFFER, sizeof(glm::mat4), sizeof(glm::mat4), glm::value_ptr(projection));
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+void CameraBlock::Destroy() {
+    glDeleteBuffers(1, &ubo);
+    ubo = 0;
+}
@@ -0,0 +1,57 @@
+// shader.h
+#pragma once
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <string>
+#include <unordered_map>
+
+// Puntos de enlace de bloques uniformes compartidos
+constexpr GLuint CAMERA_UBO_BINDING = 0;       // "Camera": view + projection, todos los programas
+constexpr GLuint GRID_BODIES_UBO_BINDING = 1;  // "Bodies": cuerpos que deforman la malla en GPU
+
+// Declaración GLSL del bloque, para pegar en los vertex shaders
+#define CAMERA_BLOCK_GLSL \
+    "layout(std140) uniform Camera {\n" \
+    "    mat4 view;\n" \
+    "    mat4 projection;\n" \
+    "};\n"
+
+// Programa enlazado con las ubicaciones de sus uniforms resueltas una sola vez.
+// Si el driver lo permite, el binario enlazado se guarda en shader_cache/ y en
+// los siguientes arranques se carga con glProgramBinary sin compilar nada.
+class ShaderProgram {
+public:
+    bool Build(const char* vSrc, const char* fSrc, const char* cacheName = nullptr,
+               const char* feedbackVarying = nullptr);
+    void Destroy();
+
+    void Use() const { glUseProgram(id); }
+    GLuint Id() const { return id; }
+    bool FromCache() const { return loadedFromCache; }
+
+    // -1 si el uniform no existe (o el compilador lo eliminó)
+    GLint Uniform(const std::string& name) const;
+
+    // Enlaza un bloque uniforme del programa (si existe) a un punto de enlace
+    void BindBlock(const char* blockName, GLuint binding) const;
+
+private:
+    GLuint id = 0;
+    bool loadedFromCache = false;
+    std::unordered_map<std::string, GLint> uniforms;
+
+    void CacheUniforms();
+    bool LoadBinary(const std::string& path);
+    void SaveBinary(const std::string& path) const;
+};
+
+// UBO de cámara: se actualiza una vez por frame y lo comparten todos los programas
+class CameraBlock {
+public:
+    void Init();
+    void Update(const glm::mat4& view, const glm::mat4& projection);
+    void Destroy();
+
+private:
+    GLuint ubo = 0;
+};
@@ -0,0 +1,253 @@
+// sim_thread.cpp
+#include "sim_thread.h"
+#include "globals.h"
+#include "spaceship.h"
+#include "profiler.h"
+#include "snapshot.h"
+#include "recording.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+extern Spaceship space;
+extern Simulation sim;
+
+SimThread simThread;
+
+// Si la física se atrasa más de esto, se descarta el retraso en vez de recuperarlo
+static const int MAX_CATCHUP_TICKS = 8;
+
+static double WallSeconds() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+SimThread::~SimThread() {
+    Stop();
+    StopRecording();
+}
+
+double SimThread::TickSeconds() const {
+    return sim.Config().fixedDt;
+}
+
+void SimThread::SetPlanets(std::vector<CelestialBody> bodies) {
+    planets = std::move(bodies);
+    orbits.Clear();
+    orbitOwners.clear();
+    for (size_t i = 0; i < planets.size(); ++i) {
+        if (!planets[i].HasOrbit()) continue;
+        orbits.Add(planets[i].Orbit());
+        orbitOwners.push_back(i);
+    }
+    UpdateOrbits();
+}
+
+void SimThread::SeekOrbits(double secondsSinceJ2000) {
+    orbitTime = secondsSinceJ2000;
+    UpdateOrbits();
+}
+
+bool SimThread::SaveSnapshot(const std::string& path) const {
+    SnapshotClock clock;
+    clock.tick = tick;
+    clock.orbitTime = orbitTime;
+    clock.timeWarp = timeWarp;
+    return WriteSnapshot(path, objs.Dense(), planets, clock);
+}
+
+bool SimThread::LoadSnapshot(const std::string& path) {
+    SnapshotFile file;
+    if (!file.Open(path)) return false;
+    std::vector<CelestialBody> restored;
+    file.Restore(objs.Dense(), restored);
+    objs.Sync();
+    SnapshotClock clock = file.Clock();
+    tick = clock.tick;
+    timeWarp = clock.timeWarp;
+    orbitTime = clock.orbitTime;
+    SetPlanets(std::move(restored));
+    // Un salto, no un movimiento: el siguiente snapshot no interpola desde el estado previo
+    lastGenerations.clear();
+    lastPlanetPositions.clear();
+    lastOrbitTime = orbitTime;
+    std::cout << "Snapshot: " << objs.Size() << " bodies, " << planets.size()
+              << " planets <- " << path << std::endl;
+    return true;
+}
+
+bool SimThread::StartRecording(const std::string& path) {
+    StopRecording();
+    auto next = std::make_unique<TrajectoryRecorder>();
+    if (!next->Open(path, TickSeconds())) return false;
+    recorder = std::move(next);
+    return true;
+}
+
+void SimThread::StopRecording() {
+    if (!recorder) return;
+    recorder->Close();
+    recorder.reset();
+}
+
+void SimThread::UpdateOrbits() {
+    if (orbitOwners.empty()) return;
+    orbits.Evaluate(orbitTime);
+    for (size_t k = 0; k < orbitOwners.size(); ++k)
+        planets[orbitOwners[k]].SetOrbitPosition(orbits.X()[k], orbits.Y()[k], orbits.Z()[k]);
+}
+
+void SimThread::Start() {
+    if (worker.joinable()) return;
+    Publish();  // el primer frame ya tiene estado que dibujar
+    stop.store(false, std::memory_order_relaxed);
+    worker = std::thread(&SimThread::Run, this);
+}
+
+void SimThread::Stop() {
+    if (!worker.joinable()) return;
+    stop.store(true, std::memory_order_release);
+    worker.join();
+}
+
+void SimThread::Run() {
+    using clock = std::chrono::steady_clock;
+    const auto period = std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(TickSeconds()));
+    auto next = clock::now();
+    while (!stop.load(std::memory_order_acquire)) {
+        Tick();
+        next += period;
+        auto now = clock::now();
+        if (now - next > period * MAX_CATCHUP_TICKS) next = now;
+        std::this_thread::sleep_until(next);
+    }
+}
+
+int SimThread::RunFor(double dt) {
+    accumulator += dt;
+    int ticks = 0;
+    const double step = TickSeconds();
+    while (accumulator >= step) {
+        Tick();
+        accumulator -= step;
+        ++ticks;
+    }
+    return ticks;
+}
+
+void SimThread::Post(std::function<void()> command) {
+    std::lock_guard<std::mutex> lock(commandMutex);
+    commands.push_back(std::move(command));
+}
+
+void SimThread::RunCommands() {
+    {
+        std::lock_guard<std::mutex> lock(commandMutex);
+        executing.swap(commands);
+    }
+    for (auto& command : executing) command();
+    executing.clear();
+}
+
+void SimThread::Tick() {
+    PROFILE_SCOPE("sim tick");
+    const float dt = static_cast<float>(TickSeconds());
+    RunCommands();
+
+    // Gravedad N-body sobre objs: un paso fijo por tick
+    if (!paused) {
+        sim.Sync(objs.Dense());
+        sim.Step();
+        sim.WriteBack(objs.Dense());
+        // Las fusiones compactan el array denso: los huecos de los absorbidos se liberan
+        if (collisions.Resolve(objs.Dense()) > 0) objs.Sync();
+    }
+    space.Update(dt);
+    for (auto& planet : planets) planet.UpdateAnimation(dt);
+    orbitTime += dt * timeWarp;
+    UpdateOrbits();
+    ++tick;
+    Publish();
+    if (recorder) recorder->Capture(objs.Dense(), planets, space.position, space.direction, tick, orbitTime);
+}
+
+void SimThread::Publish() {
+    WorldSnapshot& s = buffer.WriteBuffer();
+    s.tick = tick;
+    s.simTime = tick * TickSeconds();
+    s.publishedAt = WallSeconds();
+
+    // Posición anterior por handle: se interpola aunque las fusiones o los despawns
+    // muevan cuerpos en el array denso; un cuerpo nuevo empieza donde está
+    s.objs = objs.Dense();
+    s.prevPositions.resize(objs.Size());
+    lastPositions.resize(objs.SlotCount());
+    lastGenerations.resize(objs.SlotCount(), 0);
+    for (size_t i = 0; i < objs.Size(); ++i) {
+        const ObjectHandle h = objs[i].handle;
+        const bool seen = lastGenerations[h.index] == h.generation;
+        s.prevPositions[i] = seen ? lastPositions[h.index] : objs[i].position;
+        lastPositions[h.index] = objs[i].position;
+        lastGenerations[h.index] = h.generation;
+    }
+
+    s.planets.resize(planets.size());
+    s.planetColors.resize(planets.size());
+    s.prevPlanetPositions.resize(planets.size());
+    const bool samePlanets = lastPlanetPositions.size() == planets.size();
+    lastPlanetPositions.resize(planets.size());
+    for (size_t i = 0; i < planets.size(); ++i) {
+        s.planets[i] = planets[i].GetInstanceMatrix();
+        s.planetColors[i] = planets[i].GetColor();
+        glm::vec3 position(s.planets[i][3]);
+        s.prevPlanetPositions[i] = samePlanets ? lastPlanetPositions[i] : position;
+        lastPlanetPositions[i] = position;
+    }
+
+    s.shipPosition = space.position;
+    s.prevShipPosition = tick > 0 ? lastShipPosition : space.position;
+    s.shipDirection = space.direction;
+    lastShipPosition = space.position;
+
+    s.orbitTime = orbitTime;
+    s.prevOrbitTime = tick > 0 ? lastOrbitTime : orbitTime;
+    lastOrbitTime = orbitTime;
+    s.timeWarp = timeWarp;
+    s.stats = sim.Stats();
+    s.collisionCandidates = collisions.Stats().candidates;
+    // El pool solo lo usa este hilo: la ventana de utilización se cierra aquí
+    if (tick % STATS_TICKS == 0) {
+        threadUtil.clear();
+        for (const ThreadStats& ts : sim.Pool().Stats()) threadUtil.push_back(ts.utilization);
+        sim.Pool().ResetStats();
+    }
+    s.threadUtil = threadUtil;
+    buffer.Publish();
+}
+
+const WorldSnapshot& SimThread::Acquire() {
+    buffer.Update();
+    return buffer.ReadBuffer();
+}
+
+float SimThread::Alpha(const WorldSnapshot& snapshot) const {
+    // Ticks a mano (headless): se dibuja exactamente el último
+    if (!Running()) return 1.0f;
+    double elapsed = (WallSeconds() - snapshot.publishedAt) / TickSeconds();
+    return static_cast<float>(std::clamp(elapsed, 0.0, 1.0));
+}
+
+// Se dibuja un tick por detrás: entre el anterior y el último según alpha
+void SimThread::Interpolate(const WorldSnapshot& s, float alpha, RenderState& out) {
+    out.objs = s.objs;
+    for (size_t i = 0; i < out.objs.size(); ++i)
+        out.objs[i].position = glm::mix(s.prevPositions[i], s.objs[i].position, alpha);
+
+    out.planets = s.planets;
+    out.planetColors = s.planetColors;
+    for (size_t i = 0; i < out.planets.size(); ++i)
+        out.planets[i][3] = glm::vec4(glm::mix(s.prevPlanetPositions[i], glm::vec3(s.planets[i][3]), alpha), 1.0f);
+
+    out.shipPosition = glm::mix(s.prevShipPosition, s.shipPosition, alpha);
+    out.shipDirection = s.shipDirection;
+    out.orbitTime = s.prevOrbitTime + (s.orbitTime - s.prevOrbitTime) * alpha;
+}
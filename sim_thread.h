@@ -0,0 +1,133 @@
+// sim_thread.h
+#pragma once
+#include <glm/glm.hpp>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "object.h"
+#include "planet.h"
+#include "physics.h"
+#include "collision.h"
+#include "kepler.h"
+#include "triple_buffer.h"
+
+class TrajectoryRecorder;
+
+// Estado del mundo tras un tick, con lo necesario para interpolar desde el anterior
+struct WorldSnapshot {
+    uint64_t tick = 0;
+    double simTime = 0.0;      // segundos de escena
+    double publishedAt = 0.0;  // reloj de pared (s) al publicarse
+
+    std::vector<Object> objs;
+    std::vector<glm::vec3> prevPositions;  // objs en el tick anterior (mismo índice, casado por handle)
+    std::vector<glm::mat4> planets;        // instancias (modelo * radio)
+    std::vector<glm::vec3> prevPlanetPositions;
+    std::vector<glm::vec4> planetColors;
+    glm::vec3 shipPosition{0.0f}, prevShipPosition{0.0f}, shipDirection{0.0f, 0.0f, -1.0f};
+
+    double orbitTime = 0.0;  // segundos desde J2000 en las órbitas de los planetas
+    double prevOrbitTime = 0.0;
+    double timeWarp = 0.0;
+
+    SimStats stats;
+    size_t collisionCandidates = 0;
+    std::vector<double> threadUtil;  // del pool de la simulación, última ventana
+};
+
+// Lo que dibuja un frame: el snapshot interpolado entre los dos últimos ticks
+struct RenderState {
+    std::vector<Object> objs;
+    std::vector<glm::mat4> planets;
+    std::vector<glm::vec4> planetColors;
+    glm::vec3 shipPosition{0.0f}, shipDirection{0.0f, 0.0f, -1.0f};
+    double orbitTime = 0.0;  // para lo que se evalúa en el render (cinturón, anillos)
+};
+
+// Hilo de simulación a paso fijo: dueño de objs, de los planetas, del estado de
+// la nave y de sim. Publica un WorldSnapshot por tick en un triple buffer, así
+// que el render nunca frena a la física ni la física tira frames del render.
+// Sin Start() los ticks se dan a mano con Tick()/RunFor() (modo headless).
+class SimThread {
+public:
+    SimThread() = default;
+    ~SimThread();
+
+    SimThread(const SimThread&) = delete;
+    SimThread& operator=(const SimThread&) = delete;
+
+    void SetPlanets(std::vector<CelestialBody> bodies);
+
+    // Reloj de los planetas con órbita kepleriana: saltar a una fecha es O(1) y
+    // el factor de aceleración no cambia el coste por tick. Desde el hilo de
+    // render, vía Post().
+    void SeekOrbits(double secondsSinceJ2000);
+    void SetTimeWarp(double warp) { timeWarp = warp; }
+    double TimeWarp() const { return timeWarp; }
+
+    // Snapshots binarios de objs, planetas y relojes (en el hilo de simulación)
+    bool SaveSnapshot(const std::string& path) const;
+    bool LoadSnapshot(const std::string& path);
+
+    // Grabación de la trayectoria tick a tick (codifica y escribe otro hilo)
+    bool StartRecording(const std::string& path);
+    void StopRecording();
+
+    void Start();  // un tick cada sim.Config().fixedDt de reloj
+    void Stop();
+    bool Running() const { return worker.joinable(); }
+
+    // Un tick en el hilo que llama; RunFor consume dt con ticks enteros
+    void Tick();
+    int RunFor(double dt);
+
+    // Entrada desde el hilo de render: se ejecuta en el de simulación antes del próximo tick
+    void Post(std::function<void()> command);
+
+    // Lado render (nunca bloquea): último snapshot publicado
+    const WorldSnapshot& Acquire();
+    // Fracción [0, 1] recorrida desde el tick anterior hasta el último
+    float Alpha(const WorldSnapshot& snapshot) const;
+    static void Interpolate(const WorldSnapshot& snapshot, float alpha, RenderState& out);
+
+    double TickSeconds() const;
+
+private:
+    static constexpr uint64_t STATS_TICKS = 240;  // ventana de utilización del pool
+
+    std::vector<CelestialBody> planets;
+    KeplerOrbits orbits;
+    std::vector<size_t> orbitOwners;  // planeta de cada órbita
+    double orbitTime = 0.0;
+    double timeWarp = 1.0e6;          // segundos de órbita por segundo de escena
+    CollisionSystem collisions;
+    TripleBuffer<WorldSnapshot> buffer;
+    uint64_t tick = 0;
+    double accumulator = 0.0;
+
+    std::vector<glm::vec3> lastPositions, lastPlanetPositions;  // objs por hueco del pool
+    std::vector<uint32_t> lastGenerations;
+    glm::vec3 lastShipPosition{0.0f};
+    double lastOrbitTime = 0.0;
+    std::vector<double> threadUtil;
+
+    std::mutex commandMutex;
+    std::vector<std::function<void()>> commands, executing;
+
+    std::unique_ptr<TrajectoryRecorder> recorder;
+
+    std::thread worker;
+    std::atomic<bool> stop{false};
+
+    void Run();
+    void RunCommands();
+    void UpdateOrbits();
+    void Publish();
+};
+
+extern SimThread simThread;
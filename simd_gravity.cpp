@@ -0,0 +1,301 @@
+// simd_gravity.cpp
+#include "simd_gravity.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define GRAVITY_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define AVX2_TARGET
+#else
+#define AVX2_TARGET __attribute__((target("avx2")))
+#endif
+#endif
+
+SimdLevel DetectSimdLevel() {
+#if defined(GRAVITY_X86)
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    int maxLeaf = info[0];
+    __cpuid(info, 1);
+    bool sse2 = (info[3] & (1 << 26)) != 0;
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+    bool avx2 = false;
+    if (maxLeaf >= 7 && osxsave && avx) {
+        // El SO tiene que guardar los registros YMM
+        unsigned long long xcr0 = _xgetbv(0);
+        if ((xcr0 & 0x6) == 0x6) {
+            __cpuidex(info, 7, 0);
+            avx2 = (info[1] & (1 << 5)) != 0;
+        }
+    }
+    if (avx2) return SimdLevel::AVX2;
+    if (sse2) return SimdLevel::SSE;
+#else
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return SimdLevel::AVX2;
+    if (__builtin_cpu_supports("sse2")) return SimdLevel::SSE;
+#endif
+#endif
+    return SimdLevel::Scalar;
+}
+
+const char* SimdLevelName(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::AVX2: return "AVX2";
+        case SimdLevel::SSE:  return "SSE";
+        default:              return "scalar";
+    }
+}
+
+// Un término de la suma, compartido por la ruta escalar y las colas SIMD
+static inline void AccumulatePair(float dx, float dy, float dz, float mu, float eps2,
+                                  float& ax, float& ay, float& az) {
+    float r2 = dx * dx + dy * dy + dz * dz + eps2;
+    if (r2 <= 0.0f) return;
+    float invR = 1.0f / std::sqrt(r2);
+    float s = mu * invR * invR * invR;
+    ax += dx * s; ay += dy * s; az += dz * s;
+}
+
+static void DirectAccelScalar(const float* px, const float* py, const float* pz, const float* mu,
+                              size_t n, float eps2, float* ax, float* ay, float* az,
+                              size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+        float xi = px[i], yi = py[i], zi = pz[i];
+        float axi = 0.0f, ayi = 0.0f, azi = 0.0f;
+        for (size_t j = 0; j < n; ++j)
+            AccumulatePair(px[j] - xi, py[j] - yi, pz[j] - zi, mu[j], eps2, axi, ayi, azi);
+        ax[i] = axi; ay[i] = ayi; az[i] = azi;
+    }
+}
+
+#if defined(GRAVITY_X86)
+static inline float HorizontalSum(__m128 v) {
+    __m128 shuf = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1));
+    __m128 sums = _mm_add_ps(v, shuf);
+    shuf = _mm_movehl_ps(shuf, sums);
+    sums = _mm_add_ss(sums, shuf);
+    return _mm_cvtss_f32(sums);
+}
+
+static void DirectAccelSSE(const float* px, const float* py, const float* pz, const float* mu,
+                           size_t n, float eps2, float* ax, float* ay, float* az,
+                           size_t begin, size_t end) {
+    const __m128 vEps2 = _mm_set1_ps(eps2);
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 threeHalves = _mm_set1_ps(1.5f);
+    const __m128 zero = _mm_setzero_ps();
+    const size_t nVec = n & ~size_t(3);
+
+    for (size_t i = begin; i < end; ++i) {
+        const __m128 xi = _mm_set1_ps(px[i]), yi = _mm_set1_ps(py[i]), zi = _mm_set1_ps(pz[i]);
+        __m128 accX = zero, accY = zero, accZ = zero;
+        for (size_t j = 0; j < nVec; j += 4) {
+            __m128 dx = _mm_sub_ps(_mm_loadu_ps(px + j), xi);
+            __m128 dy = _mm_sub_ps(_mm_loadu_ps(py + j), yi);
+            __m128 dz = _mm_sub_ps(_mm_loadu_ps(pz + j), zi);
+            __m128 r2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)),
+                                   _mm_add_ps(_mm_mul_ps(dz, dz), vEps2));
+            // rsqrt (~12 bits) + Newton: y' = y * (1.5 - 0.5 * r2 * y^2)
+            __m128 y = _mm_rsqrt_ps(r2);
+            y = _mm_mul_ps(y, _mm_sub_ps(threeHalves, _mm_mul_ps(_mm_mul_ps(half, r2), _mm_mul_ps(y, y))));
+            __m128 s = _mm_mul_ps(_mm_loadu_ps(mu + j), _mm_mul_ps(y, _mm_mul_ps(y, y)));
+            s = _mm_and_ps(s, _mm_cmpgt_ps(r2, zero));
+            accX = _mm_add_ps(accX, _mm_mul_ps(dx, s));
+            accY = _mm_add_ps(accY, _mm_mul_ps(dy, s));
+            accZ = _mm_add_ps(accZ, _mm_mul_ps(dz, s));
+        }
+        float axi = HorizontalSum(accX), ayi = HorizontalSum(accY), azi = HorizontalSum(accZ);
+        for (size_t j = nVec; j < n; ++j)
+            AccumulatePair(px[j] - px[i], py[j] - py[i], pz[j] - pz[i], mu[j], eps2, axi, ayi, azi);
+        ax[i] = axi; ay[i] = ayi; az[i] = azi;
+    }
+}
+
+AVX2_TARGET static inline float HorizontalSum256(__m256 v) {
+    __m128 lo = _mm256_castps256_ps128(v);
+    __m128 hi = _mm256_extractf128_ps(v, 1);
+    return HorizontalSum(_mm_add_ps(lo, hi));
+}
+
+AVX2_TARGET static void DirectAccelAVX2(const float* px, const float* py, const float* pz, const float* mu,
+                                        size_t n, float eps2, float* ax, float* ay, float* az,
+                                        size_t begin, size_t end) {
+    const __m256 vEps2 = _mm256_set1_ps(eps2);
+    const __m256 half = _mm256_set1_ps(0.5f);
+    const __m256 threeHalves = _mm256_set1_ps(1.5f);
+    const __m256 zero = _mm256_setzero_ps();
+    const size_t nVec = n & ~size_t(7);
+
+    for (size_t i = begin; i < end; ++i) {
+        const __m256 xi = _mm256_set1_ps(px[i]), yi = _mm256_set1_ps(py[i]), zi = _mm256_set1_ps(pz[i]);
+        __m256 accX = zero, accY = zero, accZ = zero;
+        for (size_t j = 0; j < nVec; j += 8) {
+            __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(px + j), xi);
+            __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(py + j), yi);
+            __m256 dz = _mm256_sub_ps(_mm256_loadu_ps(pz + j), zi);
+            __m256 r2 = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)),
+                                      _mm256_add_ps(_mm256_mul_ps(dz, dz), vEps2));
+            __m256 y = _mm256_rsqrt_ps(r2);
+            y = _mm256_mul_ps(y, _mm256_sub_ps(threeHalves,
+                                               _mm256_mul_ps(_mm256_mul_ps(half, r2), _mm256_mul_ps(y, y))));
+            __m256 s = _mm256_mul_ps(_mm256_loadu_ps(mu + j), _mm256_mul_ps(y, _mm256_mul_ps(y, y)));
+            s = _mm256_and_ps(s, _mm256_cmp_ps(r2, zero, _CMP_GT_OQ));
+            accX = _mm256_add_ps(accX, _mm256_mul_ps(dx, s));
+            accY = _mm256_add_ps(accY, _mm256_mul_ps(dy, s));
+            accZ = _mm256_add_ps(accZ, _mm256_mul_ps(dz, s));
+        }
+        float axi = HorizontalSum256(accX), ayi = HorizontalSum256(accY), azi = HorizontalSum256(accZ);
+        for (size_t j = nVec; j < n; ++j)
+            AccumulatePair(px[j] - px[i], py[j] - py[i], pz[j] - pz[i], mu[j], eps2, axi, ayi, azi);
+        ax[i] = axi; ay[i] = ayi; az[i] = azi;
+    }
+}
+#endif
+
+static inline float GridTerm(float dx, float dy, float dz, float rs) {
+    float dm = std::sqrt(dx * dx + dy * dy + dz * dz) * 1000.0f;
+    return 200.0f * std::sqrt(std::max(rs * (dm - rs), 0.0f));
+}
+
+static void GridDisplacementScalar(const float* vx, const float* vy, const float* vz, size_t begin, size_t end,
+                                   const float* bx, const float* by, const float* bz, const float* rs,
+                                   size_t nBodies, float* out) {
+    for (size_t i = begin; i < end; ++i) {
+        float sum = 0.0f;
+        for (size_t b = 0; b < nBodies; ++b)
+            sum += GridTerm(bx[b] - vx[i], by[b] - vy[i], bz[b] - vz[i], rs[b]);
+        out[i] = sum;
+    }
+}
+
+#if defined(GRAVITY_X86)
+// Aquí se vectoriza sobre vértices (4/8 a la vez) y se recorre cada cuerpo
+// en difusión; la raíz es exacta (sqrt_ps) porque el desplazamiento se ve.
+static void GridDisplacementSSE(const float* vx, const float* vy, const float* vz, size_t begin, size_t end,
+                                const float* bx, const float* by, const float* bz, const float* rs,
+                                size_t nBodies, float* out) {
+    const __m128 toMeters = _mm_set1_ps(1000.0f), scale = _mm_set1_ps(200.0f), zero = _mm_setzero_ps();
+    size_t i = begin;
+    for (; i + 4 <= end; i += 4) {
+        __m128 x = _mm_loadu_ps(vx + i), y = _mm_loadu_ps(vy + i), z = _mm_loadu_ps(vz + i);
+        __m128 sum = zero;
+        for (size_t b = 0; b < nBodies; ++b) {
+            __m128 dx = _mm_sub_ps(_mm_set1_ps(bx[b]), x);
+            __m128 dy = _mm_sub_ps(_mm_set1_ps(by[b]), y);
+            __m128 dz = _mm_sub_ps(_mm_set1_ps(bz[b]), z);
+            __m128 d2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+            __m128 dm = _mm_mul_ps(_mm_sqrt_ps(d2), toMeters);
+            __m128 r = _mm_set1_ps(rs[b]);
+            __m128 t = _mm_max_ps(_mm_mul_ps(r, _mm_sub_ps(dm, r)), zero);
+            sum = _mm_add_ps(sum, _mm_sqrt_ps(t));
+        }
+        _mm_storeu_ps(out + i, _mm_mul_ps(sum, scale));
+    }
+    GridDisplacementScalar(vx, vy, vz, i, end, bx, by, bz, rs, nBodies, out);
+}
+
+AVX2_TARGET static void GridDisplacementAVX2(const float* vx, const float* vy, const float* vz, size_t begin, size_t end,
+                                             const float* bx, const float* by, const float* bz, const float* rs,
+                                             size_t nBodies, float* out) {
+    const __m256 toMeters = _mm256_set1_ps(1000.0f), scale = _mm256_set1_ps(200.0f), zero = _mm256_setzero_ps();
+    size_t i = begin;
+    for (; i + 8 <= end; i += 8) {
+        __m256 x = _mm256_loadu_ps(vx + i), y = _mm256_loadu_ps(vy + i), z = _mm256_loadu_ps(vz + i);
+        __m256 sum = zero;
+        for (size_t b = 0; b < nBodies; ++b) {
+            __m256 dx = _mm256_sub_ps(_mm256_set1_ps(bx[b]), x);
+            __m256 dy = _mm256_sub_ps(_mm256_set1_ps(by[b]), y);
+            __m256 dz = _mm256_sub_ps(_mm256_set1_ps(bz[b]), z);
+            __m256 d2 = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)),
+                                      _mm256_mul_ps(dz, dz));
+            __m256 dm = _mm256_mul_ps(_mm256_sqrt_ps(d2), toMeters);
+            __m256 r = _mm256_set1_ps(rs[b]);
+            __m256 t = _mm256_max_ps(_mm256_mul_ps(r, _mm256_sub_ps(dm, r)), zero);
+            sum = _mm256_add_ps(sum, _mm256_sqrt_ps(t));
+        }
+        _mm256_storeu_ps(out + i, _mm256_mul_ps(sum, scale));
+    }
+    GridDisplacementScalar(vx, vy, vz, i, end, bx, by, bz, rs, nBodies, out);
+}
+#endif
+
+void GridDisplacement(SimdLevel level,
+                      const float* vx, const float* vy, const float* vz, size_t begin, size_t end,
+                      const float* bx, const float* by, const float* bz, const float* rs, size_t nBodies,
+                      float* out) {
+#if defined(GRAVITY_X86)
+    if (level == SimdLevel::AVX2) {
+        GridDisplacementAVX2(vx, vy, vz, begin, end, bx, by, bz, rs, nBodies, out);
+        return;
+    }
+    if (level == SimdLevel::SSE) {
+        GridDisplacementSSE(vx, vy, vz, begin, end, bx, by, bz, rs, nBodies, out);
+        return;
+    }
+#endif
+    (void)level;
+    GridDisplacementScalar(vx, vy, vz, begin, end, bx, by, bz, rs, nBodies, out);
+}
+
+void DirectAccel(SimdLevel level,
+                 const float* px, const float* py, const float* pz, const float* mu, size_t n,
+                 float eps2, float* ax, float* ay, float* az, size_t begin, size_t end) {
+#if defined(GRAVITY_X86)
+    if (level == SimdLevel::AVX2) {
+        DirectAccelAVX2(px, py, pz, mu, n, eps2, ax, ay, az, begin, end);
+        return;
+    }
+    if (level == SimdLevel::SSE) {
+        DirectAccelSSE(px, py, pz, mu, n, eps2, ax, ay, az, begin, end);
+        return;
+    }
+#endif
+    (void)level;
+    DirectAccelScalar(px, py, pz, mu, n, eps2, ax, ay, az, begin, end);
+}
+
+bool SimdSelfCheck() {
+    const SimdLevel best = DetectSimdLevel();
+    std::cout << "SIMD level: " << SimdLevelName(best) << std::endl;
+
+    const size_t n = 1003;  // no múltiplo de 8: ejercita la cola escalar
+    std::mt19937 rng(42u);
+    std::uniform_real_distribution<float> pos(-20000.0f, 20000.0f);
+    std::uniform_real_distribution<float> mass(1.0f, 100.0f);
+    std::vector<float> px(n), py(n), pz(n), mu(n);
+    for (size_t i = 0; i < n; ++i) {
+        px[i] = pos(rng); py[i] = pos(rng); pz[i] = pos(rng); mu[i] = mass(rng);
+    }
+
+    std::vector<float> sx(n), sy(n), sz(n);
+    DirectAccel(SimdLevel::Scalar, px.data(), py.data(), pz.data(), mu.data(), n, 100.0f,
+                sx.data(), sy.data(), sz.data(), 0, n);
+
+    bool ok = true;
+    for (SimdLevel level : {SimdLevel::SSE, SimdLevel::AVX2}) {
+        if (level > best) continue;
+        std::vector<float> vx(n), vy(n), vz(n);
+        DirectAccel(level, px.data(), py.data(), pz.data(), mu.data(), n, 100.0f,
+                    vx.data(), vy.data(), vz.data(), 0, n);
+        float maxErr = 0.0f;
+        for (size_t i = 0; i < n; ++i) {
+            float ex = vx[i] - sx[i], ey = vy[i] - sy[i], ez = vz[i] - sz[i];
+            float ref = std::sqrt(sx[i] * sx[i] + sy[i] * sy[i] + sz[i] * sz[i]);
+            maxErr = std::max(maxErr, std::sqrt(ex * ex + ey * ey + ez * ez) / ref);
+        }
+        bool pass = maxErr <= SIMD_REL_TOLERANCE;
+        ok = ok && pass;
+        std::cout << SimdLevelName(level) << " vs scalar: max rel err " << maxErr
+                  << (pass ? " (ok)" : " (FAIL)") << std::endl;
+    }
+    return ok;
+}
@@ -0,0 +1,33 @@
+// simd_gravity.h
+#pragma once
+#include <cstddef>
+
+// Nivel de SIMD disponible, detectado en tiempo de ejecución
+enum class SimdLevel { Scalar, SSE, AVX2 };
+
+SimdLevel DetectSimdLevel();
+const char* SimdLevelName(SimdLevel level);
+
+// Suma directa con suavizado sobre arrays SoA: calcula la aceleración de los
+// cuerpos [begin, end) debida a los n cuerpos. La auto-interacción se anula
+// sola (dx = 0) y los pares con r2 == 0 se descartan.
+//
+// Las rutas SSE/AVX2 usan rsqrt + una iteración de Newton y acumulan en 4/8
+// carriles; la ruta escalar usa 1/sqrt exacto. La diferencia entre rutas es
+// menor que SIMD_REL_TOLERANCE relativo a |a| (típico ~1e-6).
+constexpr float SIMD_REL_TOLERANCE = 1e-5f;
+
+void DirectAccel(SimdLevel level,
+                 const float* px, const float* py, const float* pz, const float* mu, size_t n,
+                 float eps2, float* ax, float* ay, float* az, size_t begin, size_t end);
+
+// Desplazamiento de la malla espacio-temporal para los vértices [begin, end):
+// out[i] = sum_b 200 * sqrt(max(rs_b * (d_m - rs_b), 0)), con d_m la distancia en
+// metros (1 unidad = 1000 m, como en CreateGridVertices). Vértices y cuerpos en SoA.
+void GridDisplacement(SimdLevel level,
+                      const float* vx, const float* vy, const float* vz, size_t begin, size_t end,
+                      const float* bx, const float* by, const float* bz, const float* rs, size_t nBodies,
+                      float* out);
+
+// Compara la ruta SIMD con la escalar y muestra el error relativo máximo
+bool SimdSelfCheck();
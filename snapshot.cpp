@@ -0,0 +1,280 @@
+// snapshot.cpp
+#include "snapshot.h"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#ifdef _WIN32
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static const char SNAPSHOT_MAGIC[8] = {'G', 'R', 'A', 'V', 'S', 'N', 'A', 'P'};
+static const uint32_t BYTE_ORDER_MARK = 0x01020304;
+static const size_t WRITE_CHUNK = 1 << 16;  // elementos por escritura al volcar objs
+
+static uint64_t AlignUp(uint64_t offset) {
+    return (offset + SNAPSHOT_ALIGNMENT - 1) & ~static_cast<uint64_t>(SNAPSHOT_ALIGNMENT - 1);
+}
+
+static uint64_t SectionBytes(uint32_t section, uint64_t bodies, uint64_t planets) {
+    if (section == SECTION_PLANETS) return planets * sizeof(CelestialBodyRecord);
+    if (section == SECTION_FLAGS) return bodies;
+    return bodies * sizeof(float);
+}
+
+// Offsets de todas las secciones; devuelve el tamaño total del archivo
+static uint64_t LayoutSections(uint64_t bodies, uint64_t planets, uint64_t* offsets) {
+    uint64_t offset = AlignUp(sizeof(SnapshotHeader));
+    for (uint32_t s = 0; s < SECTION_COUNT; ++s) {
+        offsets[s] = offset;
+        offset = AlignUp(offset + SectionBytes(s, bodies, planets));
+    }
+    return offset;
+}
+
+// Valor del campo `section` del cuerpo o (solo secciones float)
+static float FloatField(const Object& o, uint32_t section) {
+    switch (section) {
+        case SECTION_POS_X: return o.position.x;
+        case SECTION_POS_Y: return o.position.y;
+        case SECTION_POS_Z: return o.position.z;
+        case SECTION_VEL_X: return o.velocity.x;
+        case SECTION_VEL_Y: return o.velocity.y;
+        case SECTION_VEL_Z: return o.velocity.z;
+        case SECTION_MASS: return o.mass;
+        case SECTION_DENSITY: return o.density;
+        case SECTION_RADIUS: return o.radius;
+        case SECTION_COLOR_R: return o.color.r;
+        case SECTION_COLOR_G: return o.color.g;
+        case SECTION_COLOR_B: return o.color.b;
+        default: return o.color.a;
+    }
+}
+
+bool WriteSnapshot(const std::string& path, const std::vector<Object>& objs,
+                   const std::vector<CelestialBody>& planets, const SnapshotClock& clock) {
+    if constexpr (std::endian::native != std::endian::little) {
+        std::cerr << "Snapshots are little-endian; this host is not" << std::endl;
+        return false;
+    }
+    SnapshotHeader header{};
+    std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = SNAPSHOT_VERSION;
+    header.byteOrder = BYTE_ORDER_MARK;
+    header.bodyCount = objs.size();
+    header.planetCount = planets.size();
+    header.tick = clock.tick;
+    header.orbitTime = clock.orbitTime;
+    header.timeWarp = clock.timeWarp;
+    header.fileSize = LayoutSections(header.bodyCount, header.planetCount, header.offsets);
+
+    const std::string tmpPath = path + ".tmp";
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            std::cerr << "Could not write snapshot " << tmpPath << std::endl;
+            return false;
+        }
+        uint64_t written = 0;
+        auto padTo = [&](uint64_t offset) {
+            static const char zeros[SNAPSHOT_ALIGNMENT] = {};
+            while (written < offset) {
+                size_t n = static_cast<size_t>(std::min<uint64_t>(offset - written, sizeof(zeros)));
+                out.write(zeros, n);
+                written += n;
+            }
+        };
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        written = sizeof(header);
+
+        // Una columna cada vez, por trozos: memoria acotada con cualquier n
+        std::vector<float> column;
+        std::vector<uint8_t> flags;
+        for (uint32_t s = 0; s < SECTION_COUNT; ++s) {
+            padTo(header.offsets[s]);
+            if (s == SECTION_PLANETS) {
+                for (const CelestialBody& planet : planets) {
+                    CelestialBodyRecord record = planet.ToRecord();
+                    out.write(reinterpret_cast<const char*>(&record), sizeof(record));
+                }
+            } else {
+                for (size_t begin = 0; begin < objs.size(); begin += WRITE_CHUNK) {
+                    size_t end = std::min(objs.size(), begin + WRITE_CHUNK);
+                    if (s == SECTION_FLAGS) {
+                        flags.resize(end - begin);
+                        for (size_t i = begin; i < end; ++i)
+                            flags[i - begin] = static_cast<uint8_t>((objs[i].Initalizing ? 1 : 0) |
+                                                                    (objs[i].Launched ? 2 : 0) |
+                                                                    (objs[i].target ? 4 : 0));
+                        out.write(reinterpret_cast<const char*>(flags.data()), flags.size());
+                    } else {
+                        column.resize(end - begin);
+                        for (size_t i = begin; i < end; ++i) column[i - begin] = FloatField(objs[i], s);
+                        out.write(reinterpret_cast<const char*>(column.data()), column.size() * sizeof(float));
+                    }
+                }
+            }
+            written += SectionBytes(s, header.bodyCount, header.planetCount);
+        }
+        padTo(header.fileSize);
+        out.close();
+        if (!out) {
+            std::cerr << "Could not write snapshot " << tmpPath << std::endl;
+            std::error_code ec;
+            std::filesystem::remove(tmpPath, ec);
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tmpPath, path, ec);
+    if (ec) {
+        std::cerr << "Could not replace snapshot " << path << ": " << ec.message() << std::endl;
+        std::filesystem::remove(tmpPath, ec);
+        return false;
+    }
+    std::cout << "Snapshot: " << objs.size() << " bodies, " << planets.size()
+              << " planets -> " << path << std::endl;
+    return true;
+}
+
+SnapshotFile::~SnapshotFile() {
+    Close();
+}
+
+bool SnapshotFile::Open(const std::string& path) {
+    Close();
+#ifdef _WIN32
+    HANDLE f = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                           FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (f == INVALID_HANDLE_VALUE) {
+        std::cerr << "Could not open snapshot " << path << std::endl;
+        return false;
+    }
+    LARGE_INTEGER fileSize;
+    GetFileSizeEx(f, &fileSize);
+    HANDLE m = fileSize.QuadPart > 0 ? CreateFileMappingA(f, nullptr, PAGE_READONLY, 0, 0, nullptr) : nullptr;
+    const void* view = m ? MapViewOfFile(m, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!view) {
+        if (m) CloseHandle(m);
+        CloseHandle(f);
+        std::cerr << "Could not map snapshot " << path << std::endl;
+        return false;
+    }
+    file = f;
+    mapping = m;
+    data = static_cast<const uint8_t*>(view);
+    size = static_cast<size_t>(fileSize.QuadPart);
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "Could not open snapshot " << path << std::endl;
+        return false;
+    }
+    struct stat st;
+    void* view = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && st.st_size > 0)
+        view = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);  // el mapeo sigue vivo sin el descriptor
+    if (view == MAP_FAILED) {
+        std::cerr << "Could not map snapshot " << path << std::endl;
+        return false;
+    }
+    data = static_cast<const uint8_t*>(view);
+    size = static_cast<size_t>(st.st_size);
+#endif
+
+    // Validación: cabecera, versión, orden de bytes y que cada sección quepa
+    const char* problem = nullptr;
+    if (size < sizeof(SnapshotHeader) || std::memcmp(Header().magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0)
+        problem = "not a snapshot file";
+    else if (Header().byteOrder != BYTE_ORDER_MARK)
+        problem = "byte order differs from this host";
+    else if (Header().version != SNAPSHOT_VERSION)
+        problem = "unsupported version";
+    else if (Header().fileSize != size)
+        problem = "truncated";
+    // Antes de multiplicar: con cuentas enormes el tamaño de sección daría la vuelta
+    else if (Header().bodyCount > size / sizeof(float) || Header().planetCount > size / sizeof(CelestialBodyRecord))
+        problem = "body count out of bounds";
+    else {
+        for (uint32_t s = 0; s < SECTION_COUNT && !problem; ++s) {
+            uint64_t offset = Header().offsets[s];
+            uint64_t bytes = SectionBytes(s, Header().bodyCount, Header().planetCount);
+            if (offset % SNAPSHOT_ALIGNMENT != 0 || offset > size || bytes > size - offset)
+                problem = "section out of bounds";
+        }
+    }
+    if (problem) {
+        std::cerr << "Invalid snapshot " << path << ": " << problem << std::endl;
+        Close();
+        return false;
+    }
+    return true;
+}
+
+void SnapshotFile::Close() {
+    if (!data) return;
+#ifdef _WIN32
+    UnmapViewOfFile(data);
+    CloseHandle(mapping);
+    CloseHandle(file);
+    mapping = file = nullptr;
+#else
+    munmap(const_cast<uint8_t*>(data), size);
+#endif
+    data = nullptr;
+    size = 0;
+}
+
+SnapshotClock SnapshotFile::Clock() const {
+    SnapshotClock clock;
+    clock.tick = Header().tick;
+    clock.orbitTime = Header().orbitTime;
+    clock.timeWarp = Header().timeWarp;
+    return clock;
+}
+
+void SnapshotFile::Restore(std::vector<Object>& objs, std::vector<CelestialBody>& planets) const {
+    const size_t n = BodyCount();
+    const float* px = Floats(SECTION_POS_X);
+    const float* py = Floats(SECTION_POS_Y);
+    const float* pz = Floats(SECTION_POS_Z);
+    const float* vx = Floats(SECTION_VEL_X);
+    const float* vy = Floats(SECTION_VEL_Y);
+    const float* vz = Floats(SECTION_VEL_Z);
+    const float* mass = Floats(SECTION_MASS);
+    const float* density = Floats(SECTION_DENSITY);
+    const float* radius = Floats(SECTION_RADIUS);
+    const float* r = Floats(SECTION_COLOR_R);
+    const float* g = Floats(SECTION_COLOR_G);
+    const float* b = Floats(SECTION_COLOR_B);
+    const float* a = Floats(SECTION_COLOR_A);
+    const uint8_t* flags = Flags();
+
+    objs.clear();
+    objs.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        objs.emplace_back(glm::vec3(px[i], py[i], pz[i]), glm::vec3(vx[i], vy[i], vz[i]), mass[i], density[i]);
+        Object& o = objs.back();
+        o.radius = radius[i];
+        o.color = glm::vec4(r[i], g[i], b[i], a[i]);
+        o.Initalizing = (flags[i] & 1) != 0;
+        o.Launched = (flags[i] & 2) != 0;
+        o.target = (flags[i] & 4) != 0;
+    }
+
+    planets.clear();
+    planets.reserve(PlanetCount());
+    const CelestialBodyRecord* records = Planets();
+    for (size_t i = 0; i < PlanetCount(); ++i) planets.push_back(CelestialBody::FromRecord(records[i]));
+}
@@ -0,0 +1,86 @@
+// snapshot.h
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "object.h"
+#include "planet.h"
+
+// Formato de snapshot binario (little-endian, versión en la cabecera): cabecera
+// fija, tabla de secciones y un array por campo (SoA), cada uno alineado a 64
+// bytes. Se lee con mmap: las secciones se usan directamente desde el mapeo.
+constexpr uint32_t SNAPSHOT_VERSION = 1;
+constexpr size_t SNAPSHOT_ALIGNMENT = 64;
+
+enum SnapshotSection : uint32_t {
+    SECTION_POS_X, SECTION_POS_Y, SECTION_POS_Z,
+    SECTION_VEL_X, SECTION_VEL_Y, SECTION_VEL_Z,
+    SECTION_MASS, SECTION_DENSITY, SECTION_RADIUS,
+    SECTION_COLOR_R, SECTION_COLOR_G, SECTION_COLOR_B, SECTION_COLOR_A,
+    SECTION_FLAGS,    // uint8: 1 Initalizing, 2 Launched, 4 target
+    SECTION_PLANETS,  // CelestialBodyRecord
+    SECTION_COUNT
+};
+
+struct SnapshotHeader {
+    char magic[8];        // "GRAVSNAP"
+    uint32_t version;
+    uint32_t byteOrder;   // 0x01020304 tal como lo escribió la máquina
+    uint64_t bodyCount;
+    uint64_t planetCount;
+    uint64_t tick;        // ticks de simulación
+    double orbitTime;     // segundos desde J2000
+    double timeWarp;
+    uint64_t fileSize;
+    uint64_t offsets[SECTION_COUNT];
+};
+
+// Estado que no está en objs ni en los planetas
+struct SnapshotClock {
+    uint64_t tick = 0;
+    double orbitTime = 0.0;
+    double timeWarp = 1.0e6;
+};
+
+// Escribe a path.tmp y renombra encima: un fallo a mitad no deja un snapshot roto
+bool WriteSnapshot(const std::string& path, const std::vector<Object>& objs,
+                   const std::vector<CelestialBody>& planets, const SnapshotClock& clock);
+
+// Snapshot mapeado en memoria de solo lectura. Open() solo valida cabecera y
+// límites de las secciones: no hay paso de parseo y los arrays se leen sin copiar.
+class SnapshotFile {
+public:
+    SnapshotFile() = default;
+    ~SnapshotFile();
+    SnapshotFile(const SnapshotFile&) = delete;
+    SnapshotFile& operator=(const SnapshotFile&) = delete;
+
+    bool Open(const std::string& path);
+    void Close();
+    bool IsOpen() const { return data != nullptr; }
+
+    const SnapshotHeader& Header() const { return *reinterpret_cast<const SnapshotHeader*>(data); }
+    size_t BodyCount() const { return static_cast<size_t>(Header().bodyCount); }
+    size_t PlanetCount() const { return static_cast<size_t>(Header().planetCount); }
+    SnapshotClock Clock() const;
+
+    const float* Floats(SnapshotSection section) const {
+        return reinterpret_cast<const float*>(data + Header().offsets[section]);
+    }
+    const uint8_t* Flags() const { return data + Header().offsets[SECTION_FLAGS]; }
+    const CelestialBodyRecord* Planets() const {
+        return reinterpret_cast<const CelestialBodyRecord*>(data + Header().offsets[SECTION_PLANETS]);
+    }
+
+    // Reconstruye objs y planetas desde las secciones (copias en bloque, sin parseo)
+    void Restore(std::vector<Object>& objs, std::vector<CelestialBody>& planets) const;
+
+private:
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+#ifdef _WIN32
+    void* file = nullptr;
+    void* mapping = nullptr;
+#endif
+};
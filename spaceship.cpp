@@ -50,18 +50,22 @@ void Spaceship::createModel() {
     glBindVertexArray(0);
 }
 
-void Spaceship::Draw(GLuint shader) const {
-    GLint modelLoc = glGetUniformLocation(shader, "model");
-    glm::mat4 model = glm::translate(glm::mat4(1.0f), position);
-    model = glm::rotate(model, glm::atan(direction.x, -direction.z), glm::vec3(0,1,0));
-    glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-
-    GLint colorLoc = glGetUniformLocation(shader, "objectColor");
-    glUniform4f(colorLoc, 1.0f, 0.3f, 0.3f, 1.0f); // rojo claro
-
-    glBindVertexArray(VAO);
-    glDrawArrays(GL_TRIANGLES, 0, vertexCount);
-    glBindVertexArray(0);
+void Spaceship::Submit(RenderQueue& queue, const ShaderProgram& shader, const glm::vec3& at,
+                       const glm::vec3& facing, const glm::vec3& eye) {
+    model = glm::translate(glm::mat4(1.0f), at);
+    model = glm::rotate(model, glm::atan(facing.x, -facing.z), glm::vec3(0,1,0));
+    material.program = &shader;
+    material.apply = [this, &shader] {
+        glUniformMatrix4fv(shader.Uniform("model"), 1, GL_FALSE, glm::value_ptr(model));
+        glUniform4f(shader.Uniform("objectColor"), 1.0f, 0.3f, 0.3f, 1.0f); // rojo claro
+    };
+    DrawPacket packet;
+    packet.material = &material;
+    packet.vao = VAO;
+    packet.mode = GL_TRIANGLES;
+    packet.count = static_cast<GLuint>(vertexCount);
+    packet.depth = glm::length(at - eye);
+    queue.Submit(packet);
 }
 
 void Spaceship::Update(float dt) {
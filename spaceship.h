@@ -3,12 +3,17 @@
 #include <GLFW/glfw3.h>
 #include <GL/glew.h>
 #include <glm/glm.hpp>
+#include "render_queue.h"
+#include "shader.h"
 
 class Spaceship {
 public:
     Spaceship();
     void Update(float deltaTime);
-    void Draw(GLuint shader) const;
+    // Con la pose de un snapshot (la nave la mueve el hilo de simulación), como
+    // paquete de la cola; los uniforms se fijan al activarse
+    void Submit(RenderQueue& queue, const ShaderProgram& shader, const glm::vec3& at,
+                const glm::vec3& facing, const glm::vec3& eye);
 
     void ProcessKeyInput(int key, int action);
     void createModel();  // ✅ Aquí, en la sección pública
@@ -19,5 +24,7 @@ public:
 private:
     GLuint VAO, VBO;
     int vertexCount = 0;
+    glm::mat4 model = glm::mat4(1.0f);  // del último Submit, hasta el Flush
+    RenderMaterial material;
 };
 
@@ -0,0 +1,185 @@
+// sphere_renderer.cpp
+#include "sphere_renderer.h"
+#include "icosphere.h"
+#include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
+#include <cstddef>
+
+static const char* instancedVertexSrc = R"glsl(
+#version 330 core
+layout(location=0) in vec3 aPos;
+layout(location=1) in mat4 iModel;   // ocupa 1..4
+layout(location=5) in vec4 iColor;
+)glsl" CAMERA_BLOCK_GLSL R"glsl(
+out vec4 vColor;
+void main(){
+    vColor = iColor;
+    gl_Position = projection * view * iModel * vec4(aPos, 1.0);
+}
+)glsl";
+
+static const char* instancedFragmentSrc = R"glsl(
+#version 330 core
+in vec4 vColor;
+out vec4 FragColor;
+void main(){
+    FragColor = vColor;
+}
+)glsl";
+
+// Subdivisiones de la icosfera de cada nivel y radio mínimo en píxeles para usarlo.
+// Sustituyen a las esferas UV de 36, 24, 16, 10 y 6 segmentos con una silueta
+// igual o mejor y de 2 a 18 veces menos vértices transformados por cuerpo.
+static const int LEVEL_SUBDIVISIONS[SphereRenderer::LOD_LEVELS] = {4, 3, 2, 1, 0};
+static const float LEVEL_MIN_PX[SphereRenderer::LOD_LEVELS] = {150.0f, 60.0f, 20.0f, 6.0f, 0.0f};
+static constexpr float HYSTERESIS = 0.2f;  // margen relativo para no saltar de nivel
+
+bool SphereRenderer::Init() {
+    if (!program.Build(instancedVertexSrc, instancedFragmentSrc, "spheres")) return false;
+
+    // Todos los niveles en un único VBO + EBO, uno detrás de otro; los índices ya
+    // llevan sumado el primer vértice de su nivel y caben en 16 bits
+    std::vector<float> vertices;
+    std::vector<GLushort> indices;
+    for (int level = 0; level < LOD_LEVELS; ++level) {
+        IndexedMesh mesh = CreateIcosphere(LEVEL_SUBDIVISIONS[level]);
+        const uint32_t baseVertex = static_cast<uint32_t>(vertices.size() / 3);
+        levelFirst[level] = static_cast<GLint>(indices.size());
+        levelCount[level] = static_cast<GLsizei>(mesh.indices.size());
+        for (uint32_t index : mesh.indices) indices.push_back(static_cast<GLushort>(baseVertex + index));
+        vertices.insert(vertices.end(), mesh.vertices.begin(), mesh.vertices.end());
+    }
+
+    // Todos los niveles en un solo VBO (atributo 0) y un EBO enlazado al VAO
+    glGenVertexArrays(1, &VAO);
+    glGenBuffers(1, &meshVBO);
+    glGenBuffers(1, &meshEBO);
+    glBindVertexArray(VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, meshVBO);
+    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, meshEBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLushort), indices.data(), GL_STATIC_DRAW);
+
+    // Buffer de instancias: mat4 en 1..4 y color en 5, avanzando una vez por instancia
+    glGenBuffers(1, &instanceVBO);
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+    for (int col = 0; col < 4; ++col) {
+        glEnableVertexAttribArray(1 + col);
+        glVertexAttribDivisor(1 + col, 1);
+    }
+    glEnableVertexAttribArray(5);
+    glVertexAttribDivisor(5, 1);
+    SetInstanceOffset(0);
+    glBindVertexArray(0);
+    return true;
+}
+
+// Apunta los atributos de instancia a partir de firstInstance (sin base instance en GL 3.3;
+// con MDI se quedan en 0 y el desplazamiento lo pone el baseInstance de cada comando)
+void SphereRenderer::SetInstanceOffset(size_t firstInstance) {
+    size_t base = firstInstance * sizeof(SphereInstance);
+    for (int col = 0; col < 4; ++col) {
+        glVertexAttribPointer(1 + col, 4, GL_FLOAT, GL_FALSE, sizeof(SphereInstance),
+                              (void*)(base + offsetof(SphereInstance, model) + sizeof(glm::vec4) * col));
+    }
+    glVertexAttribPointer(5, 4, GL_FLOAT, GL_FALSE, sizeof(SphereInstance),
+                          (void*)(base + offsetof(SphereInstance, color)));
+}
+
+void SphereRenderer::Destroy() {
+    glDeleteVertexArrays(1, &VAO);
+    glDeleteBuffers(1, &meshVBO);
+    glDeleteBuffers(1, &meshEBO);
+    glDeleteBuffers(1, &instanceVBO);
+    program.Destroy();
+    VAO = meshVBO = meshEBO = instanceVBO = 0;
+}
+
+void SphereRenderer::Begin(const glm::vec3& eyePos, const glm::mat4& projection, const glm::mat4& view,
+                           float viewportHeight) {
+    eye = eyePos;
+    pixelScale = projection[1][1] * viewportHeight * 0.5f;
+    frustum = Frustum::FromMatrix(projection * view);
+    for (auto& bucket : buckets) bucket.clear();
+    stats = LodStats();
+}
+
+// Para bajar de detalle hay que quedar claramente por debajo del umbral y para
+// subir claramente por encima; dentro del margen se mantiene el nivel anterior.
+int SphereRenderer::SelectLevel(float radiusPx, int previous) const {
+    int level = LOD_LEVELS - 1;
+    for (int l = 0; l < LOD_LEVELS; ++l) {
+        if (radiusPx >= LEVEL_MIN_PX[l]) { level = l; break; }
+    }
+    if (previous < 0 || previous >= LOD_LEVELS || previous == level) return level;
+    if (level < previous) {
+        // Sube de detalle solo si supera el umbral del nivel anterior con margen
+        return radiusPx >= LEVEL_MIN_PX[previous - 1] * (1.0f + HYSTERESIS) ? level : previous;
+    }
+    return radiusPx < LEVEL_MIN_PX[previous] * (1.0f - HYSTERESIS) ? level : previous;
+}
+
+void SphereRenderer::Add(const glm::mat4& model, const glm::vec4& color, unsigned char* lod) {
+    glm::vec3 center(model[3].x, model[3].y, model[3].z);
+    float radius = glm::length(glm::vec3(model[0].x, model[0].y, model[0].z));
+    stats.trianglesFull += levelCount[0] / 3;
+    if (!frustum.SphereVisible(center, radius)) {
+        stats.culled++;
+        return;  // conserva su nivel anterior para cuando vuelva a entrar
+    }
+
+    float dist = std::max(glm::length(center - eye) - radius, 1e-3f);
+    float radiusPx = radius * pixelScale / dist;
+
+    int level = SelectLevel(radiusPx, lod ? static_cast<int>(*lod) : -1);
+    if (lod) *lod = static_cast<unsigned char>(level);
+    buckets[level].push_back({model, color});
+
+    stats.instancesPerLevel[level]++;
+    stats.trianglesSubmitted += levelCount[level] / 3;
+}
+
+size_t SphereRenderer::InstanceCount() const {
+    size_t total = 0;
+    for (const auto& bucket : buckets) total += bucket.size();
+    return total;
+}
+
+void SphereRenderer::Submit(RenderQueue& queue) {
+    upload.clear();
+    for (const auto& bucket : buckets) upload.insert(upload.end(), bucket.begin(), bucket.end());
+    if (upload.empty()) return;
+
+    // Huérfano + subida completa: el driver no espera a que la GPU suelte el buffer anterior
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+    if (upload.size() > instanceCapacity) instanceCapacity = upload.size() * 2;
+    glBufferData(GL_ARRAY_BUFFER, instanceCapacity * sizeof(SphereInstance), nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, upload.size() * sizeof(SphereInstance), upload.data());
+
+    material.program = &program;
+    material.instanceOffset = [this](GLuint firstInstance) {
+        glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+        SetInstanceOffset(firstInstance);
+    };
+
+    // Un paquete por nivel no vacío, con sus instancias a partir de baseInstance:
+    // con MDI los cinco niveles salen en una sola llamada
+    GLuint first = 0;
+    for (int level = 0; level < LOD_LEVELS; ++level) {
+        GLuint count = static_cast<GLuint>(buckets[level].size());
+        if (count == 0) continue;
+        DrawPacket packet;
+        packet.material = &material;
+        packet.vao = VAO;
+        packet.mode = GL_TRIANGLES;
+        packet.indexType = GL_UNSIGNED_SHORT;
+        packet.first = static_cast<GLuint>(levelFirst[level]);
+        packet.count = static_cast<GLuint>(levelCount[level]);
+        packet.instanceCount = count;
+        packet.baseInstance = first;
+        queue.Submit(packet);
+        first += count;
+    }
+}
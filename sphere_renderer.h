@@ -0,0 +1,65 @@
+// sphere_renderer.h
+#pragma once
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <vector>
+#include "frustum.h"
+#include "render_queue.h"
+#include "shader.h"
+
+// Datos por instancia: matriz modelo (con la escala = radio) y color
+struct SphereInstance {
+    glm::mat4 model;
+    glm::vec4 color;
+};
+
+// Niveles de detalle de la esfera, del más fino (0) al más basto
+constexpr int SPHERE_LOD_LEVELS = 5;
+
+// Triángulos enviados en el último frame, con y sin LOD ni culling
+struct LodStats {
+    size_t trianglesFull = 0;       // si todo se dibujara al nivel 0
+    size_t trianglesSubmitted = 0;
+    size_t instancesPerLevel[SPHERE_LOD_LEVELS] = {};
+    size_t culled = 0;              // fuera del frustum, no se suben
+};
+
+// Una sola malla de esfera unitaria para todos los planetas y objetos, en una
+// cadena de niveles de detalle (icosferas indexadas, ver icosphere.h). Cada cuerpo elige nivel según su radio proyectado
+// en pantalla y se dibuja como instancia: un paquete por nivel no vacío.
+class SphereRenderer {
+public:
+    static constexpr int LOD_LEVELS = SPHERE_LOD_LEVELS;
+
+    bool Init();  // false si el programa no compila o no enlaza
+    void Destroy();
+
+    // eye/projection/viewportHeight sirven para calcular el radio en píxeles;
+    // projection * view da el frustum contra el que se descartan las esferas
+    void Begin(const glm::vec3& eye, const glm::mat4& projection, const glm::mat4& view, float viewportHeight);
+    // lod guarda el nivel del cuerpo entre frames (histéresis); puede ser nullptr
+    void Add(const glm::mat4& model, const glm::vec4& color, unsigned char* lod = nullptr);
+    // Sube las instancias y envía los niveles a la cola (view/projection: UBO de cámara)
+    void Submit(RenderQueue& queue);
+
+    size_t InstanceCount() const;
+    const LodStats& Stats() const { return stats; }
+
+private:
+    ShaderProgram program;
+    RenderMaterial material;
+    GLuint VAO = 0, meshVBO = 0, meshEBO = 0, instanceVBO = 0;
+    GLint levelFirst[LOD_LEVELS] = {};     // primer índice del nivel en el EBO
+    GLsizei levelCount[LOD_LEVELS] = {};   // índices del nivel (3 por triángulo)
+    size_t instanceCapacity = 0;
+
+    glm::vec3 eye = glm::vec3(0.0f);
+    float pixelScale = 1.0f;  // proyección[1][1] * alto / 2
+    Frustum frustum;
+    std::vector<SphereInstance> buckets[LOD_LEVELS];
+    std::vector<SphereInstance> upload;
+    LodStats stats;
+
+    int SelectLevel(float radiusPx, int previous) const;
+    void SetInstanceOffset(size_t firstInstance);  // con el VAO enlazado
+};
@@ -0,0 +1,143 @@
+// thread_pool.cpp
+#include "thread_pool.h"
+#include <algorithm>
+
+ThreadPool::ThreadPool(unsigned threads) {
+    Start(threads);
+}
+
+ThreadPool::~ThreadPool() {
+    Shutdown();
+}
+
+void ThreadPool::Start(unsigned threads) {
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    stop = false;
+    slots.clear();
+    for (unsigned i = 0; i < threads; ++i) slots.push_back(std::make_unique<Slot>());
+    // El hueco 0 es del hilo llamante; los demás tienen su propio hilo
+    for (unsigned i = 1; i < threads; ++i) workers.emplace_back(&ThreadPool::WorkerLoop, this, i);
+    statsStart = std::chrono::steady_clock::now();
+}
+
+void ThreadPool::Shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stop = true;
+    }
+    wake.notify_all();
+    for (auto& w : workers) w.join();
+    workers.clear();
+}
+
+void ThreadPool::SetThreadCount(unsigned threads) {
+    Shutdown();
+    Start(threads);
+}
+
+void ThreadPool::WorkerLoop(unsigned slot) {
+    while (true) {
+        if (RunOne(slot)) continue;
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wake.wait(lock, [this] { return stop || queued.load() > 0; });
+        if (stop) return;
+    }
+}
+
+// Saca una tarea de la cola propia (LIFO) o roba una ajena (FIFO)
+bool ThreadPool::RunOne(unsigned slot) {
+    Task task;
+    bool found = false;
+    {
+        Slot& own = *slots[slot];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.queue.empty()) {
+            task = own.queue.back();
+            own.queue.pop_back();
+            found = true;
+        }
+    }
+    const unsigned count = static_cast<unsigned>(slots.size());
+    for (unsigned k = 1; !found && k < count; ++k) {
+        Slot& victim = *slots[(slot + k) % count];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.queue.empty()) {
+            task = victim.queue.front();
+            victim.queue.pop_front();
+            found = true;
+            slots[slot]->steals.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    if (!found) return false;
+    queued.fetch_sub(1);
+    Execute(slot, task);
+    return true;
+}
+
+void ThreadPool::Execute(unsigned slot, const Task& task) {
+    auto t0 = std::chrono::steady_clock::now();
+    (*task.job->fn)(task.begin, task.end);
+    auto t1 = std::chrono::steady_clock::now();
+    Slot& s = *slots[slot];
+    s.busyNs.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count(),
+                       std::memory_order_relaxed);
+    s.tasks.fetch_add(1, std::memory_order_relaxed);
+    // Último acceso al Job: en cuanto llega a 0 el llamante puede destruirlo
+    task.job->remaining.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+void ThreadPool::ParallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& fn) {
+    if (count == 0) return;
+    grain = std::max<size_t>(1, grain);
+    const size_t chunks = (count + grain - 1) / grain;
+
+    Job job;
+    job.fn = &fn;
+    job.remaining.store(chunks);
+
+    if (chunks == 1 || slots.size() == 1) {
+        for (size_t b = 0; b < count; b += grain)
+            Execute(0, Task{&job, b, std::min(count, b + grain)});
+        return;
+    }
+
+    // Reparto inicial en bloques contiguos; el robo corrige el desequilibrio
+    const size_t threads = slots.size();
+    for (size_t t = 0; t < threads; ++t) {
+        size_t first = chunks * t / threads, last = chunks * (t + 1) / threads;
+        std::lock_guard<std::mutex> lock(slots[t]->mutex);
+        for (size_t c = first; c < last; ++c)
+            slots[t]->queue.push_back(Task{&job, c * grain, std::min(count, (c + 1) * grain)});
+    }
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        queued.fetch_add(chunks);
+    }
+    wake.notify_all();
+
+    while (job.remaining.load(std::memory_order_acquire) > 0) {
+        if (!RunOne(0)) std::this_thread::yield();
+    }
+}
+
+std::vector<ThreadStats> ThreadPool::Stats() const {
+    double wallMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - statsStart).count();
+    std::vector<ThreadStats> out(slots.size());
+    for (size_t i = 0; i < slots.size(); ++i) {
+        out[i].tasks = slots[i]->tasks.load();
+        out[i].steals = slots[i]->steals.load();
+        out[i].busyMs = slots[i]->busyNs.load() / 1.0e6;
+        out[i].utilization = wallMs > 0.0 ? out[i].busyMs / wallMs : 0.0;
+    }
+    return out;
+}
+
+void ThreadPool::ResetStats() {
+    for (auto& s : slots) {
+        s->tasks = 0;
+        s->steals = 0;
+        s->busyNs = 0;
+    }
+    statsStart = std::chrono::steady_clock::now();
+}
@@ -0,0 +1,72 @@
+// thread_pool.h
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Contadores por hilo (el hilo 0 es el que llama a ParallelFor)
+struct ThreadStats {
+    uint64_t tasks = 0;
+    uint64_t steals = 0;
+    double busyMs = 0.0;
+    double utilization = 0.0;  // busyMs / tiempo de pared desde ResetStats()
+};
+
+// Pool con work stealing: cada hilo tiene su cola, saca trabajo del final de la
+// propia y roba del principio de las ajenas cuando se queda sin nada.
+// Un solo hilo debe llamar a ParallelFor a la vez (ocupa el hueco 0).
+class ThreadPool {
+public:
+    explicit ThreadPool(unsigned threads = 0);  // 0 = std::thread::hardware_concurrency()
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void SetThreadCount(unsigned threads);
+    unsigned ThreadCount() const { return static_cast<unsigned>(slots.size()); }
+
+    // Ejecuta fn(begin, end) sobre [0, count) en trozos de `grain` y espera a
+    // que terminen todos. El hilo que llama también trabaja.
+    void ParallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& fn);
+
+    std::vector<ThreadStats> Stats() const;
+    void ResetStats();
+
+private:
+    struct Job {
+        const std::function<void(size_t, size_t)>* fn;
+        std::atomic<size_t> remaining;
+    };
+    struct Task {
+        Job* job;
+        size_t begin, end;
+    };
+    struct Slot {
+        std::mutex mutex;
+        std::deque<Task> queue;
+        std::atomic<uint64_t> tasks{0}, steals{0}, busyNs{0};
+    };
+
+    std::vector<std::unique_ptr<Slot>> slots;
+    std::vector<std::thread> workers;
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+    std::atomic<size_t> queued{0};
+    bool stop = false;
+    std::chrono::steady_clock::time_point statsStart;
+
+    void Start(unsigned threads);
+    void Shutdown();
+    void WorkerLoop(unsigned slot);
+    bool RunOne(unsigned slot);
+    void Execute(unsigned slot, const Task& task);
+};
@@ -0,0 +1,153 @@
+// trail_renderer.cpp
+#include "trail_renderer.h"
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+
+static const char* trailVertexSrc = R"glsl(
+#version 330 core
+layout(location=0) in vec4 aPosTime;
+layout(location=1) in vec4 aColor;
+)glsl" CAMERA_BLOCK_GLSL R"glsl(
+uniform float now;
+uniform float fadeSeconds;
+out vec4 vColor;
+void main(){
+    float age = clamp((now - aPosTime.w) / fadeSeconds, 0.0, 1.0);
+    vColor = vec4(aColor.rgb, aColor.a * (1.0 - age));
+    gl_Position = projection * view * vec4(aPosTime.xyz, 1.0);
+}
+)glsl";
+
+static const char* trailFragmentSrc = R"glsl(
+#version 330 core
+in vec4 vColor;
+out vec4 FragColor;
+void main(){
+    FragColor = vColor;
+}
+)glsl";
+
+static uint32_t PackColor(const glm::vec4& c) {
+    auto channel = [](float v) { return static_cast<uint32_t>(std::clamp(v, 0.0f, 1.0f) * 255.0f + 0.5f); };
+    return channel(c.r) | channel(c.g) << 8 | channel(c.b) << 16 | channel(c.a) << 24;
+}
+
+bool TrailRenderer::Init() {
+    if (!program.Build(trailVertexSrc, trailFragmentSrc, "trails")) return false;
+    trails.assign(MAX_TRAILS, Trail());
+    const GLsizeiptr bytes = static_cast<GLsizeiptr>(MAX_TRAILS * SLOT_VERTICES * sizeof(TrailVertex));
+
+    // Un VBO con MAX_TRAILS huecos de SLOT_VERTICES vértices, reescrito cada frame
+    glGenVertexArrays(1, &VAO);
+    glGenBuffers(1, &VBO);
+    glBindVertexArray(VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    if (GLEW_ARB_buffer_storage) {
+        // Mapeo persistente y coherente: Push escribe directo en memoria visible por la GPU
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_ARRAY_BUFFER, bytes, nullptr, flags);
+        mapped = static_cast<TrailVertex*>(glMapBufferRange(GL_ARRAY_BUFFER, 0, bytes, flags));
+    }
+    if (!mapped) {
+        glBufferData(GL_ARRAY_BUFFER, bytes, nullptr, GL_STREAM_DRAW);
+        shadow.resize(MAX_TRAILS * SLOT_VERTICES);
+    }
+
+    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, sizeof(TrailVertex), (void*)offsetof(TrailVertex, position));
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(TrailVertex), (void*)offsetof(TrailVertex, color));
+    glEnableVertexAttribArray(1);
+    glBindVertexArray(0);
+
+    std::cout << "[render] trails: " << MAX_TRAILS << " x " << POINTS_PER_TRAIL << " points, "
+              << (mapped ? "persistent mapped" : "orphaned uploads") << std::endl;
+    return true;
+}
+
+void TrailRenderer::Destroy() {
+    if (mapped) {
+        glBindBuffer(GL_ARRAY_BUFFER, VBO);
+        glUnmapBuffer(GL_ARRAY_BUFFER);
+        mapped = nullptr;
+    }
+    glDeleteVertexArrays(1, &VAO);
+    glDeleteBuffers(1, &VBO);
+    program.Destroy();
+    shadow.clear();
+    trails.clear();
+}
+
+TrailRenderer::TrailVertex* TrailRenderer::Slot(size_t trail) {
+    TrailVertex* base = mapped ? mapped : shadow.data();
+    return base + trail * SLOT_VERTICES;
+}
+
+void TrailRenderer::Push(size_t trail, const glm::vec3& position, const glm::vec4& color, float time) {
+    if (trail >= trails.size()) return;  // fuera del presupuesto: sin estela
+    Trail& t = trails[trail];
+    if (t.count > 0 && time < t.lastTime) t = Trail();
+    if (t.count > 0 && time - t.lastTime < SAMPLE_SECONDS) return;
+
+    // El vértice que se pisa es el más viejo, ya transparente: si un frame en
+    // vuelo lo lee a medias no se nota
+    TrailVertex* slot = Slot(trail);
+    const TrailVertex v = {position, time, PackColor(color)};
+    slot[t.head] = v;
+    if (t.head == 0) slot[POINTS_PER_TRAIL] = v;
+    t.head = (t.head + 1) % POINTS_PER_TRAIL;
+    t.count = std::min(t.count + 1, POINTS_PER_TRAIL);
+    t.lastTime = time;
+    t.last = position;
+    usedSlots = std::max(usedSlots, trail + 1);
+}
+
+void TrailRenderer::Clear(size_t trail) {
+    if (trail < trails.size()) trails[trail] = Trail();
+}
+
+void TrailRenderer::Submit(RenderQueue& queue, float time, const glm::vec3& eye) {
+    if (!mapped && usedSlots > 0) {
+        // Sin mapeo persistente: buffer nuevo y subida de la copia local, solo los huecos usados
+        glBindBuffer(GL_ARRAY_BUFFER, VBO);
+        glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(MAX_TRAILS * SLOT_VERTICES * sizeof(TrailVertex)),
+                     nullptr, GL_STREAM_DRAW);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, static_cast<GLsizeiptr>(usedSlots * SLOT_VERTICES * sizeof(TrailVertex)),
+                        shadow.data());
+    }
+
+    material.program = &program;
+    material.apply = [this, time] {
+        glUniform1f(program.Uniform("now"), time);
+        glUniform1f(program.Uniform("fadeSeconds"), FADE_SECONDS);
+    };
+
+    // Uno o dos tramos por estela: [head, N] (lo viejo, más la copia del 0) y [0, head).
+    // Son transparentes: la cola las ordena de lejos a cerca por su punto más nuevo
+    // y, como comparten material y VAO, siguen saliendo en una sola llamada.
+    DrawPacket packet;
+    packet.material = &material;
+    packet.vao = VAO;
+    packet.mode = GL_LINE_STRIP;
+    packet.layer = RenderLayer::Transparent;
+    activeTrails = 0;
+    for (size_t i = 0; i < usedSlots; ++i) {
+        const Trail& t = trails[i];
+        if (t.count < 2) continue;
+        ++activeTrails;
+        const GLuint base = static_cast<GLuint>(i * SLOT_VERTICES);
+        packet.depth = glm::length(t.last - eye);
+        if (t.count < POINTS_PER_TRAIL || t.head == 0) {
+            packet.first = base;
+            packet.count = t.count;
+            queue.Submit(packet);
+        } else {
+            packet.first = base + t.head;
+            packet.count = SLOT_VERTICES - t.head;
+            queue.Submit(packet);
+            packet.first = base;
+            packet.count = t.head;
+            queue.Submit(packet);
+        }
+    }
+}
@@ -0,0 +1,65 @@
+// trail_renderer.h
+#pragma once
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "render_queue.h"
+#include "shader.h"
+
+// Estelas detrás de planetas, objetos y nave. Cada estela tiene un hueco fijo de
+// POINTS_PER_TRAIL puntos en un único buffer de GPU y se usa como anillo:
+// añadir un punto es escribir un vértice, sin realocar nunca. El buffer se
+// escribe mapeado de forma persistente (GL_ARB_buffer_storage) o, si no hay,
+// con una copia en CPU que se sube huérfana cada frame. Cada tramo es un paquete
+// de la cola y todas las estelas salen en una sola llamada.
+class TrailRenderer {
+public:
+    static constexpr uint32_t POINTS_PER_TRAIL = 256;
+    static constexpr size_t MAX_TRAILS = 4096;       // 4096 * 257 * 20 B = 21 MB
+    static constexpr float SAMPLE_SECONDS = 1.0f / 30.0f;
+    static constexpr float FADE_SECONDS = POINTS_PER_TRAIL * SAMPLE_SECONDS;
+
+    bool Init();  // false si el programa no compila o no enlaza
+    void Destroy();
+
+    // O(1). Como mucho un punto por SAMPLE_SECONDS; si el tiempo retrocede
+    // (reproducción hacia atrás) la estela vuelve a empezar
+    void Push(size_t trail, const glm::vec3& position, const glm::vec4& color, float time);
+    void Clear(size_t trail);
+
+    // eye ordena las estelas por distancia (view/projection: UBO de cámara)
+    void Submit(RenderQueue& queue, float time, const glm::vec3& eye);
+
+    bool Persistent() const { return mapped != nullptr; }
+    size_t ActiveTrails() const { return activeTrails; }
+
+private:
+    // Cada hueco tiene un vértice más: copia del 0 en la posición N, así el tramo
+    // [head, N] enlaza con [0, head) sin perder el segmento del salto
+    static constexpr uint32_t SLOT_VERTICES = POINTS_PER_TRAIL + 1;
+
+    struct TrailVertex {
+        glm::vec3 position;
+        float time;
+        uint32_t color;  // RGBA8
+    };
+    struct Trail {
+        uint32_t head = 0, count = 0;
+        float lastTime = 0.0f;
+        glm::vec3 last = glm::vec3(0.0f);  // punto más nuevo
+    };
+
+    ShaderProgram program;
+    RenderMaterial material;
+    GLuint VAO = 0, VBO = 0;
+    TrailVertex* mapped = nullptr;   // mapeo persistente
+    std::vector<TrailVertex> shadow; // sin buffer_storage
+    size_t usedSlots = 0;            // huecos hasta el último con datos (lo que se sube)
+    size_t activeTrails = 0;
+
+    std::vector<Trail> trails;
+
+    TrailVertex* Slot(size_t trail);
+};
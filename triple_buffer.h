@@ -0,0 +1,34 @@
+// triple_buffer.h
+#pragma once
+#include <atomic>
+
+// Triple buffer sin locks para un escritor y un lector. El escritor rellena su
+// hueco y lo intercambia con el del medio; el lector se queda con el del medio
+// solo si hay uno nuevo. Ninguno espera nunca al otro: si el lector va lento se
+// pierden estados intermedios, si va rápido repite el último.
+template <typename T>
+class TripleBuffer {
+public:
+    // Lado escritor: hueco propio, nadie más lo toca hasta Publish()
+    T& WriteBuffer() { return slots[back]; }
+    void Publish() {
+        back = middle.exchange(back | FRESH, std::memory_order_acq_rel) & INDEX;
+    }
+
+    // Lado lector: true si había un estado nuevo y ReadBuffer() ahora lo devuelve
+    bool Update() {
+        if (!(middle.load(std::memory_order_relaxed) & FRESH)) return false;
+        front = middle.exchange(front, std::memory_order_acq_rel) & INDEX;
+        return true;
+    }
+    const T& ReadBuffer() const { return slots[front]; }
+
+private:
+    static constexpr int INDEX = 3;
+    static constexpr int FRESH = 4;  // el del medio aún no lo ha visto el lector
+
+    T slots[3];
+    std::atomic<int> middle{1};
+    int back = 0;   // solo escritor
+    int front = 2;  // solo lector
+};